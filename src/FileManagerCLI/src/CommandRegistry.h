@@ -0,0 +1,78 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef COMMANDREGISTRY_H
+#define COMMANDREGISTRY_H
+
+#include <array>
+#include <string_view>
+
+#include "Enumerators/CommandsEnum.h"
+#include "Core/PerfectHash.h"
+
+/*
+ * Command & flag tables. The lookups in `Util` are perfect hashes generated from
+ * them at compile time, and `sudo -h` prints its options from `sudo_flag_specs`.
+ */
+
+struct CommandSpec
+{
+    std::string_view name;
+    Command command;
+};
+
+struct FlagSpec
+{
+    std::string_view name;
+    Flag flag;
+    std::array<std::string_view, 3> help{};     // One entry per help line, unused ones left empty
+};
+
+inline constexpr std::array command_specs = {
+    CommandSpec{"sudo", Command::sudo},
+    CommandSpec{"exit", Command::exit},
+    CommandSpec{"useradd", Command::useradd},
+    CommandSpec{"passwd", Command::passwd},
+};
+
+// In the order `sudo -h` lists them
+inline constexpr std::array sudo_flag_specs = {
+    FlagSpec{"-h", Flag::sudo_h, {"Display this help message and exit."}},
+    FlagSpec{"-v", Flag::sudo_v, {"Display the current user's cached credentials,",
+                                  "and verify if they are still valid."}},
+    FlagSpec{"-k", Flag::sudo_k, {"Invalidates the user's cached credentials, forcing",
+                                  "the user to authenticate again for the next sudo command."}},
+    FlagSpec{"-u", Flag::sudo_u, {"Run the specified COMMAND as the specified user",
+                                  "(instead of root). You must be allowed to run the command",
+                                  "as that user in the sudoers file."}},
+    FlagSpec{"-i", Flag::sudo_i, {"Start a shell as the target user (root by default)."}},
+};
+
+inline constexpr std::array useradd_flag_specs = {
+    FlagSpec{"-m", Flag::useradd_m},
+    FlagSpec{"-s", Flag::useradd_s},
+    FlagSpec{"-g", Flag::useradd_g},
+};
+
+inline constexpr std::array passwd_flag_specs = {
+    FlagSpec{"-d", Flag::passwd_d},
+};
+
+template <typename Value, typename Spec, size_t N, typename Projection>
+consteval auto MakeLookup(const std::array<Spec, N> &specs, Projection value_of)
+{
+    std::array<typename PerfectHashMap<Value, N>::Entry, N> entries{};
+    for (size_t i = 0; i < N; i++) entries[i] = {specs[i].name, value_of(specs[i])};
+
+    return PerfectHashMap<Value, N>(entries);
+}
+
+inline constexpr auto flag_of = [](const FlagSpec &spec) { return spec.flag; };
+
+inline constexpr auto command_lookup = MakeLookup<Command>(command_specs, [](const CommandSpec &spec) { return spec.command; });
+inline constexpr auto sudo_flag_lookup = MakeLookup<Flag>(sudo_flag_specs, flag_of);
+inline constexpr auto useradd_flag_lookup = MakeLookup<Flag>(useradd_flag_specs, flag_of);
+inline constexpr auto passwd_flag_lookup = MakeLookup<Flag>(passwd_flag_specs, flag_of);
+
+#endif //COMMANDREGISTRY_H
@@ -4,6 +4,7 @@
 
 #include "Manager.h"
 #include "Util.h"
+#include "CommandRegistry.h"
 #include "Core/Core.h"
 #include "CommandProcessor/CommandProcessor.h"
 
@@ -53,7 +54,6 @@ void Manager::Start()
 
 bool Manager::HandleCommand(const size_t argc, std::vector<std::string>& argv)
 {
-    Util::ToLower(argv[0]);
     const Command first_command = Util::GetCommand(argv[0]);
 
     if (first_command == Command::none) {
@@ -100,7 +100,6 @@ bool Manager::Sudo(const size_t argc, std::vector<std::string> &argv)
 {
     for (size_t i = 1; i < argc; i++) {
         if (argv[i][0] != '-') {
-            Util::ToLower(argv[i]);
             const Command command = Util::GetCommand(argv[i]);
 
             if (command == Command::none) {
@@ -117,7 +116,6 @@ bool Manager::Sudo(const size_t argc, std::vector<std::string> &argv)
             }
 
         } else {
-            Util::ToLower(argv[i]);
             const Flag sudo_flag = Util::GetSudoFlag(argv[i]);
 
             switch (sudo_flag) {
@@ -223,11 +221,10 @@ bool Manager::HandleSudoUFlag(const std::string &username, const size_t command_
         return false;
     }
 
-    Util::ToLower(argv[command_index]);
     const Command command = Util::GetCommand(argv[command_index]);
     if (command == Command::none) {
 
-        if (argv[command_index] == "-i") {
+        if (Util::GetSudoFlag(argv[command_index]) == Flag::sudo_i) {
             if (command_index != argc - 1) {
                 Log::LOG(LogLevel::ERROR, "Invalid argument after 'sudo -u <username> -i'. The 'sudo' command with '-u' and '-i' should not have additional arguments.");
                 return false;
@@ -263,12 +260,9 @@ void Manager::SudoHelp()
     std::cout << "Run a command as another user, typically with elevated privileges (root).\n\n";
     std::cout << "Options:\n";
     std::cout << std::left;
-    std::cout << std::setw(7) << "  -h" << std::setw(30) << "Display this help message and exit.\n";
-    std::cout << std::setw(7) << "  -v" << std::setw(30) << "Display the current user's cached credentials,\n";
-    std::cout << std::setw(7) << "    " << std::setw(30) << "and verify if they are still valid.\n";
-    std::cout << std::setw(7) << "  -k" << std::setw(30) << "Invalidates the user's cached credentials, forcing\n";
-    std::cout << std::setw(7) << "    " << std::setw(30) << "the user to authenticate again for the next sudo command.\n";
-    std::cout << std::setw(7) << "  -u" << std::setw(30) << "Run the specified COMMAND as the specified user\n";
-    std::cout << std::setw(7) << "    " << std::setw(30) << "(instead of root). You must be allowed to run the command\n";
-    std::cout << std::setw(7) << "    " << std::setw(30) << "as that user in the sudoers file.\n";
+    for (const auto& spec : sudo_flag_specs) {
+        for (size_t line = 0; line < spec.help.size() && !spec.help[line].empty(); line++) {
+            std::cout << std::setw(7) << (line == 0 ? "  " + std::string(spec.name) : "    ") << spec.help[line] << "\n";
+        }
+    }
 }
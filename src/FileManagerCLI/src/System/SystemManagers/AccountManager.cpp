@@ -70,7 +70,6 @@ void AccountManager::ParseUseradd(const size_t starting_index, const size_t argc
             return;
         } else {
             // Here we are getting the flag
-            Util::ToLower(argv[i]);
             const Flag useradd_flag = Util::GetUseraddFlag(argv[i]);
 
             switch (useradd_flag) {
@@ -200,8 +199,6 @@ void AccountManager::ParsePasswd(const size_t starting_index, const size_t argc,
             Log::LOG(LogLevel::ERROR, "Invalid argument. The 'passwd' command expects flags and their associated values.");
             return;
         } else {
-            Util::ToLower(argv[i]);
-
             switch (Util::GetPasswdFlag(argv[i])) {
                 case Flag::passwd_d:
                     // If just flag is given without value
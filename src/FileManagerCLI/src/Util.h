@@ -5,16 +5,19 @@
 #ifndef UTIL_H
 #define UTIL_H
 
+#include <string_view>
+
 #include "Enumerators/CommandsEnum.h"
 
 class Util {
 public:
     static void ToLower(std::string& str);
-    static Command GetCommand(const std::string &command_str);
+    /* Lookups ignore case, so callers do not need to lowercase first */
+    static Command GetCommand(std::string_view command_str);
     /* Flags */
-    static Flag GetSudoFlag(const std::string &sudo_flag_str);
-    static Flag GetUseraddFlag(const std::string &useradd_flag_str);
-    static Flag GetPasswdFlag(const std::string &passwd_flag_str);
+    static Flag GetSudoFlag(std::string_view sudo_flag_str);
+    static Flag GetUseraddFlag(std::string_view useradd_flag_str);
+    static Flag GetPasswdFlag(std::string_view passwd_flag_str);
 };
 
 
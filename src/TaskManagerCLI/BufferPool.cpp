@@ -0,0 +1,50 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "BufferPool.h"
+
+BufferPool::Page BufferPool::Find(const size_t page)
+{
+    const auto it = m_slots.find(page);
+    if (it == m_slots.end()) {
+        m_stats.misses++;
+        return nullptr;
+    }
+
+    m_stats.hits++;
+    Frame &frame = m_frames[it->second];
+    frame.referenced = true;
+    return frame.data;
+}
+
+void BufferPool::Insert(const size_t page, Page data)
+{
+    // Frames are only added while the pool is filling up, afterwards a page always takes over a victim's frame
+    if (m_frames.size() < m_capacity) {
+        m_slots.emplace(page, m_frames.size());
+        m_frames.push_back({page, std::move(data), true});
+        return;
+    }
+
+    // Every frame is passed at most once with its bit set, so the sweep ends within two turns of the clock
+    while (m_frames[m_hand].referenced) {
+        m_frames[m_hand].referenced = false;
+        m_hand = (m_hand + 1) % m_frames.size();
+    }
+
+    Frame &victim = m_frames[m_hand];
+    m_slots.erase(victim.page);
+    m_stats.evictions++;
+
+    victim = {page, std::move(data), true};
+    m_slots.emplace(page, m_hand);
+    m_hand = (m_hand + 1) % m_frames.size();
+}
+
+void BufferPool::Clear()
+{
+    m_frames.clear();
+    m_slots.clear();
+    m_hand = 0;
+}
@@ -0,0 +1,76 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "TaskTable.h"
+
+struct BufferPoolStats
+{
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+};
+
+/* BufferPool
+ * ------------------------------------------------------------------------------
+ * The pages of a `PagedStore` held in memory, at most `capacity` of them, each
+ * decoded into a table of its own. Replacement is CLOCK: every frame has a
+ * reference bit, set when its page is fetched; the hand sweeps the frames,
+ * clearing set bits, and evicts the first page whose bit is already clear.
+ * - Fetch  -> The page from its frame, or from `load` on a miss (which then takes
+ *             a frame). A page `load` fails on is not cached, nullptr is returned.
+ * - Insert -> Gives a page the caller decoded itself a frame, without counting a
+ *             miss. The page must not be in the pool yet.
+ * Pages are handed out shared, so an evicted page a caller still holds lives on
+ * until the caller lets go of it: the pool bounds what it keeps, not what its
+ * callers keep.
+ */
+class BufferPool final
+{
+public:
+    using Page = std::shared_ptr<const TaskTable>;
+
+    explicit BufferPool(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)) { m_frames.reserve(m_capacity); }
+
+    template <typename Load>
+    Page Fetch(const size_t page, Load &&load)
+    {
+        if (Page cached = Find(page)) return cached;
+
+        Page loaded = load(page);
+        if (loaded) Insert(page, loaded);
+        return loaded;
+    }
+
+    void Insert(size_t page, Page data);
+    void Clear();
+
+    size_t Capacity() const { return m_capacity; }
+    size_t size() const { return m_frames.size(); }
+    const BufferPoolStats& Stats() const { return m_stats; }
+private:
+    struct Frame
+    {
+        size_t page;
+        Page data;
+        bool referenced;
+    };
+
+    Page Find(size_t page);
+
+    size_t m_capacity;
+    std::vector<Frame> m_frames;
+    std::unordered_map<size_t, size_t> m_slots;     // Page number -> frame
+    size_t m_hand{0};
+    BufferPoolStats m_stats{};
+};
+
+#endif //BUFFERPOOL_H
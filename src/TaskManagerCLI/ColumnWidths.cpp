@@ -0,0 +1,81 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "ColumnWidths.h"
+#include "OutputBuffer.h"
+
+#include <algorithm>
+
+/* --------------------Consts-------------------- */
+
+// Header-driven minimum width of every column, before padding
+static constexpr ColumnArray MIN_WIDTHS = {4, 11, 9, 8, 7, 4};
+static constexpr size_t PADDING = 2;
+static constexpr size_t BORDERS = 14;
+
+/* --------------------Table Layout-------------------- */
+
+TableLayout TableLayout::FromContentWidths(const ColumnArray& content_widths)
+{
+    TableLayout layout;
+
+    for (size_t column = 0; column < COLUMN_COUNT; column++) {
+        layout.widths[column] = std::max(MIN_WIDTHS[column], content_widths[column]) + PADDING;
+        layout.total_width += layout.widths[column];
+    }
+
+    layout.total_width += BORDERS;
+    return layout;
+}
+
+/* --------------------Column Widths-------------------- */
+
+ColumnArray ColumnWidths::Measure(const Task& task, const TaskTable& tasks)
+{
+    return {
+        OutputBuffer::DigitCount(task.id),
+        task.description_length,
+        static_cast<size_t>(task.due == 0 ? 0 : 10),
+        priority_names[static_cast<size_t>(task.priority)].length(),
+        static_cast<size_t>(task.status == Status::Pending ? 8 : 9),
+        tasks.TagsLength(task)
+    };
+}
+
+void ColumnWidths::Add(const Task& task, const TaskTable& tasks)
+{
+    const ColumnArray widths = Measure(task, tasks);
+
+    for (size_t column = 0; column < COLUMN_COUNT; column++) {
+        std::vector<size_t>& counts = m_counts[column];
+        const size_t width = widths[column];
+
+        if (counts.size() <= width) counts.resize(width + 1, 0);
+        counts[width]++;
+        m_max[column] = std::max(m_max[column], width);
+    }
+}
+
+void ColumnWidths::Remove(const Task& task, const TaskTable& tasks)
+{
+    const ColumnArray widths = Measure(task, tasks);
+
+    for (size_t column = 0; column < COLUMN_COUNT; column++) {
+        std::vector<size_t>& counts = m_counts[column];
+        const size_t width = widths[column];
+
+        if (width >= counts.size() || counts[width] == 0) continue;
+        counts[width]--;
+
+        // Only the removal of the last widest cell moves the maximum
+        size_t& max = m_max[column];
+        while (max > 0 && counts[max] == 0) max--;
+    }
+}
+
+void ColumnWidths::Clear()
+{
+    for (auto &counts : m_counts) counts.clear();
+    m_max.fill(0);
+}
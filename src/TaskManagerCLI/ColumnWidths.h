@@ -0,0 +1,64 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef COLUMNWIDTHS_H
+#define COLUMNWIDTHS_H
+
+#include <array>
+#include <vector>
+
+#include "TaskTable.h"
+
+// Columns of the task table, in display order
+enum class Column
+{
+    ID,
+    Description,
+    Due,
+    Priority,
+    Status,
+    Tags,
+    Count
+};
+
+static constexpr size_t COLUMN_COUNT = static_cast<size_t>(Column::Count);
+
+using ColumnArray = std::array<size_t, COLUMN_COUNT>;
+
+/* TableLayout
+ * ------------------------------------------------------------------------------
+ * Final column widths of the task table (content, minimum and padding applied)
+ * and the width of the horizontal borders.
+ */
+struct TableLayout
+{
+    ColumnArray widths{};
+    size_t total_width{};
+
+    static TableLayout FromContentWidths(const ColumnArray& content_widths);
+};
+
+/* ColumnWidths
+ * ------------------------------------------------------------------------------
+ * Widest cell of every column, maintained incrementally as tasks enter, change
+ * and leave the store. Each column keeps a counter per cell width, so removing
+ * the widest row only walks down to the next width that is still in use.
+ */
+class ColumnWidths final
+{
+public:
+    /* Cell widths of a single task of the given table */
+    static ColumnArray Measure(const Task& task, const TaskTable& tasks);
+
+    void Add(const Task& task, const TaskTable& tasks);
+    void Remove(const Task& task, const TaskTable& tasks);
+    void Clear();
+
+    TableLayout Layout() const { return TableLayout::FromContentWidths(m_max); }
+private:
+    std::array<std::vector<size_t>, COLUMN_COUNT> m_counts {};
+    ColumnArray m_max {};
+};
+
+#endif //COLUMNWIDTHS_H
@@ -0,0 +1,61 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "CommandLine.h"
+#include "PlainText.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+void PrintEmptyQuotesError(std::ostream& out, const bool plain)
+{
+    out << Icon("❌ ", plain) << "Error: Quoted text cannot be empty or contain only spaces.\n"
+        << Icon("🔹 ", plain) << "Example of correct usage: search --description \"important task\"\n"
+        << Icon("🔹 ", plain) << "Incorrect: search --description \"   \" (only spaces inside quotes)\n";
+}
+
+void GetInput(const std::string& input, CommandLine& line, bool& empty_quote)
+{
+    // The arena never outgrows the input, so reserving up front keeps every view valid
+    line.arena.clear();
+    line.arena.reserve(input.size());
+    line.tokens.clear();
+
+    size_t arg_start{0};
+    bool inside_quotes{false};
+    empty_quote = false;
+
+    const auto push_arg = [&line, &arg_start] {
+        line.tokens.emplace_back(line.arena.data() + arg_start, line.arena.size() - arg_start);
+        arg_start = line.arena.size();
+    };
+
+    for (const char c : input) {
+        const bool arg_empty = line.arena.size() == arg_start;
+
+        if (c == ' ' && !inside_quotes) {
+            if (!arg_empty) push_arg();
+        } else if (c == '"') {
+            inside_quotes = !inside_quotes;
+
+            if (!inside_quotes && !arg_empty) {
+                if (std::all_of(line.arena.begin() + static_cast<std::ptrdiff_t>(arg_start), line.arena.end(),
+                    [](const char chr){ return std::isspace(chr); })) {
+                    empty_quote = true;
+                    return;
+                }
+                push_arg();
+            } else if (!inside_quotes && arg_empty) {
+                empty_quote = true;
+                return;
+            }
+        } else {
+            line.arena.push_back(c);
+        }
+    }
+
+    // It is possible that the last word was not pushed into the vector, so we explicitly check for it
+    if (line.arena.size() != arg_start) push_arg();
+}
@@ -0,0 +1,44 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * CommandLine
+ * ------------------------------------------------------------------------------
+ * One tokenized input line. The text of every word (without its quotes) is copied
+ * into `arena`, and `tokens` are views into it. Both keep their capacity from line
+ * to line, so reading a command does not allocate once the buffers have grown.
+ */
+struct CommandLine
+{
+    std::string arena;
+    std::vector<std::string_view> tokens;
+};
+
+/*
+ * GetInput(const std::string& input, CommandLine& line, bool& empty_quote)
+ * ------------------------------------------------------------------------------
+ * Parses user input, splitting it into separate words.
+ * - Words inside **double quotes ("...")** are treated as a **single argument**
+ *   regardless of spaces within them.
+ * - Extra spaces between words are ignored.
+ */
+void GetInput(const std::string &input, CommandLine &line, bool& empty_quote);
+
+/*
+ * PrintEmptyQuotesError(std::ostream& out, bool plain)
+ * ------------------------------------------------------------------------------
+ * Reported for a line with `""` or a quoted run of spaces in it, without emoji
+ * decoration if `plain`.
+ */
+void PrintEmptyQuotesError(std::ostream& out = std::cout, bool plain = false);
+
+#endif //COMMANDLINE_H
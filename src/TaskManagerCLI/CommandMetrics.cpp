@@ -0,0 +1,59 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "CommandMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+/* --------------------Latency Histogram-------------------- */
+
+std::uint64_t LatencyHistogram::BucketUpperBound(const size_t bucket)
+{
+    if (bucket < SUB_BUCKETS) return bucket;
+
+    const std::uint64_t shift = bucket / SUB_BUCKETS - 1;
+    const std::uint64_t lower = (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lower + (std::uint64_t{1} << shift) - 1;
+}
+
+std::uint64_t LatencyHistogram::Percentile(const double p) const
+{
+    if (m_count == 0) return 0;
+
+    // The rank of the sample that sits at the quantile, counted from 1
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(m_count))));
+
+    std::uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < m_counts.size(); bucket++) {
+        seen += m_counts[bucket];
+        if (seen >= rank) return std::min(BucketUpperBound(bucket), m_max);
+    }
+
+    return m_max;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    m_runs += other.m_runs;
+    if (other.m_count == 0) return;
+    if (m_counts.empty()) m_counts.resize(BUCKET_COUNT);
+
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) m_counts[bucket] += other.m_counts[bucket];
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_max = std::max(m_max, other.m_max);
+}
+
+/* --------------------Command Metrics-------------------- */
+
+void CommandMetrics::Merge(const CommandMetrics &other)
+{
+    for (size_t command = 0; command < latency.size(); command++) latency[command].Merge(other.latency[command]);
+
+    rows_scanned += other.rows_scanned;
+    rows_returned += other.rows_returned;
+    bytes_read += other.bytes_read;
+    bytes_written += other.bytes_written;
+}
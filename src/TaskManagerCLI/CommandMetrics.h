@@ -0,0 +1,104 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef COMMANDMETRICS_H
+#define COMMANDMETRICS_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "Tasks.h"
+
+/* LatencyHistogram
+ * ------------------------------------------------------------------------------
+ * HDR-style histogram of durations in nanoseconds. Values below 2^SUB_BUCKET_BITS
+ * get a bucket each; above that every power of two is split into 2^SUB_BUCKET_BITS
+ * linear sub-buckets, so a sample is bucketed in O(1) (one bit scan) with a
+ * relative error under 1/2^SUB_BUCKET_BITS (~3%). Samples past 2^MAX_BITS ns
+ * (~18 minutes) land in the last bucket. The buckets are allocated by the first
+ * sample, so commands that never run cost nothing.
+ *
+ * Reading the clock twice costs more than 10% of the fastest commands, so they
+ * are sampled: every run is counted, but once a command has taken less than
+ * `ALWAYS_TIMED_NS` only one run in `SAMPLE_INTERVAL` is timed. The first run is
+ * always timed, and slower commands are timed every time.
+ * - Due        -> Counts a run, returns whether it is to be timed.
+ * - Record     -> Adds the duration of a timed run.
+ * - Percentile -> Upper bound of the bucket holding the p-th quantile (p in
+ *                 [0, 1]) of the timed runs, capped at the largest sample.
+ * - Merge      -> Adds the runs and samples of another histogram.
+ */
+class LatencyHistogram final
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr unsigned MAX_BITS = 40;
+    static constexpr std::uint64_t ALWAYS_TIMED_NS = 10'000;
+    static constexpr std::uint64_t SAMPLE_INTERVAL = 128;      // A power of two
+
+    bool Due() { return (m_runs++ & (m_interval - 1)) == 0; }
+
+    void Record(const std::uint64_t ns)
+    {
+        if (m_counts.empty()) m_counts.resize(BUCKET_COUNT);
+
+        m_counts[BucketOf(ns)]++;
+        m_count++;
+        m_total += ns;
+        if (ns > m_max) m_max = ns;
+        m_interval = ns < ALWAYS_TIMED_NS ? SAMPLE_INTERVAL : 1;
+    }
+
+    std::uint64_t Runs() const { return m_runs; }
+    std::uint64_t Count() const { return m_count; }
+    std::uint64_t Total() const { return m_total; }
+    std::uint64_t Max() const { return m_max; }
+    std::uint64_t Percentile(double p) const;
+    void Merge(const LatencyHistogram &other);
+private:
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static size_t BucketOf(std::uint64_t ns)
+    {
+        if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+        if (ns >> MAX_BITS) return BUCKET_COUNT - 1;
+
+        const unsigned shift = static_cast<unsigned>(std::bit_width(ns)) - 1 - SUB_BUCKET_BITS;
+        return static_cast<size_t>((shift + 1) * SUB_BUCKETS + (ns >> shift) - SUB_BUCKETS);
+    }
+
+    static std::uint64_t BucketUpperBound(size_t bucket);
+
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_runs{0};
+    std::uint64_t m_interval{1};
+    std::uint64_t m_count{0};             // Timed runs
+    std::uint64_t m_total{0};
+    std::uint64_t m_max{0};
+};
+
+/* CommandMetrics
+ * ------------------------------------------------------------------------------
+ * What a manager has done since it was created, shown by `stats`: the latency of
+ * every command it executed, the rows its commands looked at and handed back,
+ * and the bytes it moved through files. Only touched by the manager's own
+ * thread, so the counters are plain integers; `Merge` sums up the metrics of
+ * several managers (the readers of a server).
+ */
+struct CommandMetrics
+{
+
+    std::array<LatencyHistogram, static_cast<size_t>(Command::None)> latency{};
+    std::uint64_t rows_scanned{0};      // Tasks a command examined (scans, index probes, exports)
+    std::uint64_t rows_returned{0};     // Tasks a command printed or exported
+    std::uint64_t bytes_read{0};        // Store loads and imported files
+    std::uint64_t bytes_written{0};     // Exported files and one-shot store saves (the persistence thread counts its own)
+
+    void Merge(const CommandMetrics &other);
+};
+
+#endif //COMMANDMETRICS_H
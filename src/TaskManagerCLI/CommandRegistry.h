@@ -0,0 +1,222 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef COMMANDREGISTRY_H
+#define COMMANDREGISTRY_H
+
+#include <array>
+#include <string_view>
+
+#include "Tasks.h"
+#include "PerfectHash.h"
+
+/* Command & Flag Registry
+ * ------------------------------------------------------------------------------
+ * Single table describing every command and flag: its name and short alias,
+ * where it shows up in `help`, and which flags a command accepts. The parser's
+ * lookup tables, the help text and the "Allowed flags" errors are all derived
+ * from it, so adding a command or a flag is a one-line change here.
+ */
+
+inline constexpr size_t MAX_COMMAND_FLAGS = 8;
+
+struct FlagList
+{
+    std::array<Flag, MAX_COMMAND_FLAGS> flags{};
+    size_t count{0};
+
+    constexpr const Flag* begin() const { return flags.data(); }
+    constexpr const Flag* end() const { return flags.data() + count; }
+    constexpr bool empty() const { return count == 0; }
+};
+
+template <typename... Flags>
+constexpr FlagList AllowedFlags(const Flags... flags)
+{
+    static_assert(sizeof...(Flags) <= MAX_COMMAND_FLAGS, "Raise MAX_COMMAND_FLAGS");
+    return FlagList{{flags...}, sizeof...(Flags)};
+}
+
+enum class HelpSection
+{
+    Tasks,
+    Viewing,
+    Tags,
+    Files,
+    Configuration,
+    General,
+    Count
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(HelpSection::Count)> help_section_titles = {
+    "📌 Task Management Commands:",
+    "📋 Viewing & Searching Commands:",
+    "🏷️ Tag Management:",
+    "🔄 Undo & File Management:",
+    "⚙️ Configuration:",
+    "🆘 General Commands:"
+};
+
+struct CommandSpec
+{
+    std::string_view name;
+    std::string_view alias;
+    Command command;
+    HelpSection section;
+    std::string_view icon;      // Includes the padding that lines the names up in `help`
+    std::string_view summary;
+    FlagList flags;
+    std::string_view note{};    // Optional extra line printed under the summary
+};
+
+struct FlagSpec
+{
+    std::string_view name;
+    std::string_view alias;
+    Flag flag;
+    std::string_view argument;  // Empty for flags that take no value
+    std::string_view summary;
+    bool multiple{false};       // Whether the flag accepts a list of values
+};
+
+/* --------------------Tables-------------------- */
+
+// Kept in `Command` order, so a spec can be fetched by indexing with the enum
+inline constexpr std::array command_specs = {
+    CommandSpec{"add", "a", Command::Add, HelpSection::Tasks, "➕ ",
+        "Add a new task (Requires: --description) [Optional: --priority, --due, --tags]",
+        AllowedFlags(Flag::Description, Flag::Priority, Flag::Due, Flag::Tags)},
+    CommandSpec{"list", "ls", Command::List, HelpSection::Viewing, "📋 ",
+        "Show all tasks [Optional: --limit & --offset, or --top & --by & --order]",
+        AllowedFlags(Flag::Limit, Flag::Offset, Flag::Top, Flag::SortBy, Flag::SortOrder)},
+    CommandSpec{"edit", "e", Command::Edit, HelpSection::Tasks, "✏️  ",
+        "Modify a task (Requires: --id) [Optional: --description, --priority, --due, --tags, --status]",
+        AllowedFlags(Flag::ID, Flag::Description, Flag::Priority, Flag::Due, Flag::Tags, Flag::Status)},
+    CommandSpec{"delete", "rm", Command::Delete, HelpSection::Tasks, "🗑  ",
+        "Remove tasks (Requires: --id and/or --where)",
+        AllowedFlags(Flag::ID, Flag::Where)},
+    CommandSpec{"complete", "c", Command::Complete, HelpSection::Tasks, "✅ ",
+        "Mark tasks as completed (Requires: --id and/or --where)",
+        AllowedFlags(Flag::ID, Flag::Where)},
+    CommandSpec{"search", "s", Command::Search, HelpSection::Viewing, "🔍 ",
+        "Find tasks by description or tags (Requires: --description OR --tags) [Optional: --include-archived]",
+        AllowedFlags(Flag::Description, Flag::Tags, Flag::IncludeArchived)},
+    CommandSpec{"filter", "f", Command::Filter, HelpSection::Viewing, "🔎 ",
+        "Filter tasks by status, priority, or due date (Use one of: --status, --priority, --due & --to)",
+        AllowedFlags(Flag::Status, Flag::Priority, Flag::Due, Flag::To)},
+    CommandSpec{"sort", "sr", Command::Sort, HelpSection::Viewing, "🔀 ",
+        "Sort tasks (Requires: --by) [Optional: --order]",
+        AllowedFlags(Flag::SortBy, Flag::SortOrder)},
+    CommandSpec{"next", "n", Command::Next, HelpSection::Viewing, "👉 ",
+        "Show what to do next: pending tasks by priority, then due date, then ID [Optional: --top (Default: 1)]",
+        AllowedFlags(Flag::Top)},
+    CommandSpec{"report", "rp", Command::Report, HelpSection::Viewing, "📈 ",
+        "Count the tasks by status x priority, by tag and by due week [Optional: --json]",
+        AllowedFlags(Flag::Json)},
+    CommandSpec{"tag", "t", Command::Tag, HelpSection::Tags, "🏷️  ",
+        "Show all used tags (--list), or change tags (Requires: --id and/or --where, & --add / --remove)",
+        AllowedFlags(Flag::ID, Flag::Where, Flag::Add, Flag::Remove, Flag::List, Flag::Rename, Flag::Merge, Flag::Into),
+        "Tags can also be renamed (--rename OLD NEW) or merged (--merge a b ... --into d) on every task at once"},
+    CommandSpec{"undo", "u", Command::Undo, HelpSection::Files, "🔄 ",
+        "Revert the last change (No flags required)",
+        AllowedFlags()},
+    CommandSpec{"export", "exp", Command::Export, HelpSection::Files, "📂 ",
+        "Save tasks to a file (Requires: --file)",
+        AllowedFlags(Flag::File)},
+    CommandSpec{"import", "imp", Command::Import, HelpSection::Files, "📥 ",
+        "Load tasks from one or more files (Requires: --file) [Optional: --mode]",
+        AllowedFlags(Flag::File, Flag::Mode),
+        "Both accept csv/txt/json, and gzip-compressed csv.gz/txt.gz/json.gz"},
+    CommandSpec{"archive", "ar", Command::Archive, HelpSection::Files, "🗄️  ",
+        "Move completed tasks to the compressed archive (tasks.archive) [Optional: --before]",
+        AllowedFlags(Flag::Before),
+        "Archived tasks leave every command but `search --include-archived`, and undo stops at the archive"},
+    CommandSpec{"config", "cfg", Command::Config, HelpSection::Configuration, "⚙️  ",
+        "Set default priority for new tasks (--default-priority) or the auto-archive age (--auto-archive)",
+        AllowedFlags(Flag::DefaultPriority, Flag::AutoArchive)},
+    CommandSpec{"stats", "st", Command::Stats, HelpSection::General, "📊 ",
+        "Show per-command latency, rows scanned/returned, bytes read/written and history size [Optional: --json]",
+        AllowedFlags(Flag::Json, Flag::Memory),
+        "With --memory: the bytes, allocations and objects held by the tasks, indexes, tags, history, flags and config"},
+    CommandSpec{"help", "h", Command::Help, HelpSection::General, "🆘 ",
+        "Show this guide",
+        AllowedFlags()},
+    CommandSpec{"exit", "q", Command::Exit, HelpSection::General, "❌ ",
+        "Exit the Task Manager",
+        AllowedFlags()},
+};
+
+// Kept in `Flag` order, so a spec can be fetched by indexing with the enum
+inline constexpr std::array flag_specs = {
+    FlagSpec{"description", "d", Flag::Description, "[TEXT]", "Description of the task (Required for `add`)"},
+    FlagSpec{"priority", "p", Flag::Priority, "[high|medium|low|none]", "Task priority (Optional for `add`, `edit`, `filter`)"},
+    FlagSpec{"due", "du", Flag::Due, "[YYYY-MM-DD]", "Due date of the task (Optional for `add`, `edit`, `filter`)"},
+    FlagSpec{"tags", "tg", Flag::Tags, "[tag1 tag2 ...]", "Tags for categorization (Optional for `add`, `edit`)", true},
+    FlagSpec{"id", "i", Flag::ID, "[NUMBER ...]", "Task ID (`edit`), or IDs and ranges like `1 5 9-200` (`delete`, `complete`, `tag`)", true},
+    FlagSpec{"status", "s", Flag::Status, "[pending|completed]", "Change task status (For `edit`, `filter`)"},
+    FlagSpec{"to", "t", Flag::To, "[YYYY-MM-DD]", "End date for filtering (Used with `--due` in `filter`)"},
+    FlagSpec{"by", "b", Flag::SortBy, "[priority|due|id|status]", "Sorting criteria (Required for `sort`)"},
+    FlagSpec{"order", "o", Flag::SortOrder, "[asc|desc]", "Sorting order (Default: asc)"},
+    FlagSpec{"add", "a", Flag::Add, "[TAG]", "Add a tag to the selected tasks (Used with `tag`)"},
+    FlagSpec{"remove", "r", Flag::Remove, "[TAG]", "Remove a tag from the selected tasks (Used with `tag`)"},
+    FlagSpec{"list", "l", Flag::List, "", "List all available tags (Used with `tag` command)"},
+    FlagSpec{"file", "f", Flag::File, "[filename ...]", "Specify file name for `export`, one or more for `import`", true},
+    FlagSpec{"default-priority", "dp", Flag::DefaultPriority, "[high|medium|low|none]", "Default priority for new tasks (Used with `config`)"},
+    FlagSpec{"mode", "m", Flag::Mode, "[skip|upsert|replace]", "How `import` treats existing IDs (Default: skip)"},
+    FlagSpec{"limit", "lm", Flag::Limit, "[NUMBER]", "Maximum number of tasks shown by `list`"},
+    FlagSpec{"offset", "of", Flag::Offset, "[NUMBER]", "Number of tasks `list` skips before the page"},
+    FlagSpec{"top", "tp", Flag::Top, "[NUMBER]", "Show the first N tasks by `--by` (priority: highest first), or the next N to do (`next`)"},
+    FlagSpec{"where", "w", Flag::Where, "[field<op>value ...]", "Select tasks by id/status/priority/due/tag, ops = != < <= > >= (all must hold)", true},
+    FlagSpec{"rename", "rn", Flag::Rename, "[OLD NEW]", "Rename a tag on every task carrying it (Used with `tag`)", true},
+    FlagSpec{"merge", "mg", Flag::Merge, "[tag1 tag2 ...]", "Tags to fold into the `--into` tag on every task (Used with `tag`)", true},
+    FlagSpec{"into", "in", Flag::Into, "[TAG]", "Tag the `--merge` tags are folded into"},
+    FlagSpec{"sync", "sy", Flag::Sync, "", "Return only once the change is on disk (Accepted by every command)"},
+    FlagSpec{"json", "js", Flag::Json, "", "Print the statistics / the report as JSON (Used with `stats`, `report`)"},
+    FlagSpec{"memory", "mem", Flag::Memory, "", "Show the memory held by every subsystem instead (Used with `stats`)"},
+    FlagSpec{"before", "bf", Flag::Before, "[YYYY-MM-DD]", "Archive only the completed tasks due before this date (Used with `archive`)"},
+    FlagSpec{"include-archived", "ia", Flag::IncludeArchived, "", "Search the archived tasks too (Used with `search`)"},
+    FlagSpec{"auto-archive", "aa", Flag::AutoArchive, "[DAYS]", "Archive completed tasks due over DAYS days ago on every load, 0 = off (Used with `config`)"},
+};
+
+static_assert(command_specs.size() == static_cast<size_t>(Command::None), "Every command needs a spec");
+static_assert(flag_specs.size() == static_cast<size_t>(Flag::None), "Every flag needs a spec");
+
+static_assert([] {
+    for (size_t i = 0; i < command_specs.size(); i++)
+        if (static_cast<size_t>(command_specs[i].command) != i) return false;
+    for (size_t i = 0; i < flag_specs.size(); i++)
+        if (static_cast<size_t>(flag_specs[i].flag) != i) return false;
+    return true;
+}(), "Specs must follow the enum order");
+
+/* --------------------Lookup-------------------- */
+
+// Every spec is reachable by its name and by its alias
+template <typename Value, typename Spec, size_t N, typename Projection>
+consteval auto MakeLookup(const std::array<Spec, N> &specs, Projection value_of)
+{
+    using Map = PerfectHashMap<Value, N * 2>;
+
+    std::array<typename Map::Entry, N * 2> entries{};
+    for (size_t i = 0; i < N; i++) {
+        entries[2 * i] = {specs[i].name, value_of(specs[i])};
+        entries[2 * i + 1] = {specs[i].alias, value_of(specs[i])};
+    }
+
+    return Map(entries);
+}
+
+inline constexpr auto command_lookup = MakeLookup<Command>(command_specs, [](const CommandSpec &spec) { return spec.command; });
+inline constexpr auto flag_lookup = MakeLookup<Flag>(flag_specs, [](const FlagSpec &spec) { return spec.flag; });
+
+constexpr Command LookupCommand(const std::string_view name) { return command_lookup.Find(name, Command::None); }
+constexpr Flag LookupFlag(const std::string_view name) { return flag_lookup.Find(name, Flag::None); }
+
+constexpr const CommandSpec& GetCommandSpec(const Command command) { return command_specs[static_cast<size_t>(command)]; }
+constexpr const FlagSpec& GetFlagSpec(const Flag flag) { return flag_specs[static_cast<size_t>(flag)]; }
+
+static_assert(LookupCommand("LS") == Command::List && LookupCommand("lists") == Command::None);
+static_assert(LookupFlag("Default-Priority") == Flag::DefaultPriority && LookupFlag("") == Flag::None);
+
+#endif //COMMANDREGISTRY_H
@@ -0,0 +1,152 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef FLAGMAP_H
+#define FLAGMAP_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Tasks.h"
+
+/* FlagValues
+ * ------------------------------------------------------------------------------
+ * The values given to one flag, as views into the command line. The first few
+ * live inline; longer lists (`--tags a b c d e ...`) spill into a vector whose
+ * capacity survives `clear`, so a steady stream of commands never allocates.
+ */
+class FlagValues final
+{
+public:
+    static constexpr size_t INLINE_CAPACITY = 4;
+
+    FlagValues() = default;
+    explicit FlagValues(std::pmr::memory_resource *resource) : m_spilled(resource) {}
+    FlagValues(const std::initializer_list<std::string_view> values) { for (const auto value : values) push_back(value); }
+
+    FlagValues& operator=(const std::initializer_list<std::string_view> values)
+    {
+        clear();
+        for (const auto value : values) push_back(value);
+        return *this;
+    }
+
+    void push_back(const std::string_view value)
+    {
+        if (m_size < INLINE_CAPACITY) {
+            m_inline[m_size++] = value;
+            return;
+        }
+
+        if (m_size == INLINE_CAPACITY) m_spilled.assign(m_inline.begin(), m_inline.end());
+        m_spilled.push_back(value);
+        m_size++;
+    }
+
+    void clear()
+    {
+        m_size = 0;
+        m_spilled.clear();
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const std::string_view* begin() const { return m_size > INLINE_CAPACITY ? m_spilled.data() : m_inline.data(); }
+    const std::string_view* end() const { return begin() + m_size; }
+    const std::string_view& operator[](const size_t index) const { return begin()[index]; }
+private:
+    std::array<std::string_view, INLINE_CAPACITY> m_inline{};
+    std::pmr::vector<std::string_view> m_spilled{};
+    size_t m_size{0};
+};
+
+/* FlagMap
+ * ------------------------------------------------------------------------------
+ * Flag -> values map backed by one slot per `Flag` and a bit mask of the flags
+ * in use. It keeps the parts of the `std::unordered_map` interface the manager
+ * relies on: `operator[]` inserts, `size` counts the flags given, and iteration
+ * visits them (in enum order) as `[flag, values]` pairs. Spilled value lists
+ * come from the given memory resource.
+ */
+class FlagMap final
+{
+public:
+    class Iterator final
+    {
+    public:
+        Iterator(const FlagMap &map, const std::uint32_t remaining) : m_map(&map), m_remaining(remaining) {}
+
+        std::pair<Flag, const FlagValues&> operator*() const
+        {
+            const auto flag = static_cast<Flag>(std::countr_zero(m_remaining));
+            return {flag, m_map->m_values[static_cast<size_t>(flag)]};
+        }
+
+        Iterator& operator++()
+        {
+            m_remaining &= m_remaining - 1;
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return m_remaining == other.m_remaining; }
+    private:
+        const FlagMap *m_map;
+        std::uint32_t m_remaining;
+    };
+
+    explicit FlagMap(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : m_values(MakeValues(resource, std::make_index_sequence<FLAG_COUNT>{})) {}
+
+    FlagValues& operator[](const Flag flag)
+    {
+        m_present |= Bit(flag);
+        return m_values[static_cast<size_t>(flag)];
+    }
+
+    void erase(const Flag flag)
+    {
+        m_values[static_cast<size_t>(flag)].clear();
+        m_present &= ~Bit(flag);
+    }
+
+    bool contains(const Flag flag) const { return (m_present & Bit(flag)) != 0; }
+    const FlagValues& at(const Flag flag) const { return m_values[static_cast<size_t>(flag)]; }
+
+    size_t size() const { return static_cast<size_t>(std::popcount(m_present)); }
+    bool empty() const { return m_present == 0; }
+
+    void clear()
+    {
+        for (auto remaining = m_present; remaining != 0; remaining &= remaining - 1) {
+            m_values[static_cast<size_t>(std::countr_zero(remaining))].clear();
+        }
+        m_present = 0;
+    }
+
+    Iterator begin() const { return {*this, m_present}; }
+    Iterator end() const { return {*this, 0}; }
+private:
+    static constexpr size_t FLAG_COUNT = static_cast<size_t>(Flag::None);
+    static_assert(FLAG_COUNT <= 32, "The mask holds one bit per flag");
+
+    static constexpr std::uint32_t Bit(const Flag flag) { return std::uint32_t{1} << static_cast<size_t>(flag); }
+
+    // Every slot is built in place on the resource, a moved-in vector would keep the default one
+    template <size_t... Index>
+    static std::array<FlagValues, FLAG_COUNT> MakeValues(std::pmr::memory_resource *resource, std::index_sequence<Index...>)
+    {
+        return {((void)Index, FlagValues(resource))...};
+    }
+
+    std::array<FlagValues, FLAG_COUNT> m_values;
+    std::uint32_t m_present{0};
+};
+
+#endif //FLAGMAP_H
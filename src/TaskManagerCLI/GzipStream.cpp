@@ -0,0 +1,168 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "GzipStream.h"
+
+/* --------------------Consts-------------------- */
+
+static constexpr size_t CHUNK_SIZE = 1 << 16;
+static constexpr size_t QUEUE_CAPACITY = 8;
+
+/* --------------------Chunk Queue-------------------- */
+
+bool ChunkQueue::Push(std::string chunk)
+{
+    std::unique_lock lock(m_mutex);
+    m_not_full.wait(lock, [this] { return m_chunks.size() < m_capacity || m_closed; });
+    if (m_closed) return false;
+
+    m_chunks.push_back(std::move(chunk));
+    m_not_empty.notify_one();
+    return true;
+}
+
+bool ChunkQueue::Pop(std::string &chunk)
+{
+    std::unique_lock lock(m_mutex);
+    m_not_empty.wait(lock, [this] { return !m_chunks.empty() || m_closed; });
+    if (m_chunks.empty()) return false;
+
+    chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    m_not_full.notify_one();
+    return true;
+}
+
+void ChunkQueue::Close()
+{
+    std::lock_guard lock(m_mutex);
+    m_closed = true;
+    m_not_empty.notify_all();
+    m_not_full.notify_all();
+}
+
+/* --------------------Gzip Output-------------------- */
+
+GzipOutputBuffer::GzipOutputBuffer(const std::string &file_path)
+    : m_file(gzopen(file_path.c_str(), "wb")), m_queue(QUEUE_CAPACITY)
+{
+    if (!m_file) return;
+
+    m_chunk.reserve(CHUNK_SIZE);
+    m_worker = std::thread(&GzipOutputBuffer::Compress, this);
+}
+
+GzipOutputBuffer::~GzipOutputBuffer()
+{
+    Close();
+}
+
+bool GzipOutputBuffer::Close()
+{
+    if (!m_file) return !m_failed;
+
+    PushChunk();
+    m_queue.Close();
+    m_worker.join();
+
+    if (gzclose(m_file) != Z_OK) m_failed = true;
+    m_file = nullptr;
+
+    return !m_failed;
+}
+
+GzipOutputBuffer::int_type GzipOutputBuffer::overflow(const int_type ch)
+{
+    if (!m_file) return traits_type::eof();
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+
+    m_chunk.push_back(traits_type::to_char_type(ch));
+    if (m_chunk.size() >= CHUNK_SIZE) PushChunk();
+
+    return ch;
+}
+
+std::streamsize GzipOutputBuffer::xsputn(const char *s, const std::streamsize count)
+{
+    if (!m_file) return 0;
+
+    m_chunk.append(s, static_cast<size_t>(count));
+    if (m_chunk.size() >= CHUNK_SIZE) PushChunk();
+
+    return count;
+}
+
+void GzipOutputBuffer::PushChunk()
+{
+    if (m_chunk.empty()) return;
+
+    std::string chunk;
+    chunk.reserve(CHUNK_SIZE);
+    chunk.swap(m_chunk);
+    m_queue.Push(std::move(chunk));
+}
+
+void GzipOutputBuffer::Compress()
+{
+    std::string chunk;
+
+    while (m_queue.Pop(chunk)) {
+        if (m_failed) continue; // Keep draining so the producer never blocks forever
+
+        if (gzwrite(m_file, chunk.data(), static_cast<unsigned>(chunk.size())) != static_cast<int>(chunk.size()))
+            m_failed = true;
+    }
+}
+
+/* --------------------Gzip Input-------------------- */
+
+GzipInputBuffer::GzipInputBuffer(const std::string &file_path)
+    : m_file(gzopen(file_path.c_str(), "rb")), m_queue(QUEUE_CAPACITY)
+{
+    if (!m_file) return;
+
+    gzbuffer(m_file, CHUNK_SIZE);
+    m_worker = std::thread(&GzipInputBuffer::Decompress, this);
+}
+
+GzipInputBuffer::~GzipInputBuffer()
+{
+    if (!m_file) return;
+
+    // Unblocks the worker if the reader stopped before the end of the file
+    m_queue.Close();
+    m_worker.join();
+    gzclose(m_file);
+}
+
+GzipInputBuffer::int_type GzipInputBuffer::underflow()
+{
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    if (!m_file || !m_queue.Pop(m_chunk)) return traits_type::eof();
+
+    setg(m_chunk.data(), m_chunk.data(), m_chunk.data() + m_chunk.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+void GzipInputBuffer::Decompress()
+{
+    int read;
+    while (true) {
+        std::string chunk(CHUNK_SIZE, '\0');
+
+        read = gzread(m_file, chunk.data(), static_cast<unsigned>(chunk.size()));
+        if (read <= 0) break;
+
+        chunk.resize(static_cast<size_t>(read));
+        if (!m_queue.Push(std::move(chunk))) return;
+    }
+
+    // A read error and a file cut short both end the stream early, only zlib knows it was not the real end.
+    // Set before the queue is closed, so the reader sees it once it runs out of chunks.
+    int error = Z_OK;
+    const char *message = gzerror(m_file, &error);
+    if (read < 0 || error != Z_OK) m_error = message;
+
+    m_queue.Close();
+}
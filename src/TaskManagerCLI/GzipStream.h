@@ -0,0 +1,134 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef GZIPSTREAM_H
+#define GZIPSTREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <zlib.h>
+
+/* ChunkQueue
+ * ------------------------------------------------------------------------------
+ * Bounded hand-off queue between the formatting/parsing thread and the zlib
+ * worker. `Push` blocks while the queue is full and returns false once the
+ * queue is closed, `Pop` blocks while it is empty and returns false once the
+ * queue is closed and drained.
+ */
+class ChunkQueue final
+{
+public:
+    explicit ChunkQueue(size_t capacity) : m_capacity(capacity) {}
+
+    bool Push(std::string chunk);
+    bool Pop(std::string &chunk);
+    void Close();
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::deque<std::string> m_chunks;
+    size_t m_capacity;
+    bool m_closed{false};
+};
+
+/* GzipOutputBuffer
+ * ------------------------------------------------------------------------------
+ * Stream buffer that collects formatted output into fixed size chunks and hands
+ * them to a worker thread which deflates them into a `.gz` file.
+ */
+class GzipOutputBuffer final : public std::streambuf
+{
+public:
+    explicit GzipOutputBuffer(const std::string &file_path);
+    ~GzipOutputBuffer() override;
+
+    bool IsOpen() const { return m_file != nullptr; }
+
+    /* Flushes the pending chunk, waits for the worker and closes the file.
+     * Returns false if zlib reported an error at any point. */
+    bool Close();
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char *s, std::streamsize count) override;
+private:
+    void PushChunk();
+    void Compress();
+
+    gzFile m_file{nullptr};
+    std::string m_chunk;
+    ChunkQueue m_queue;
+    std::thread m_worker;
+    bool m_failed{false};
+};
+
+/* GzipInputBuffer
+ * ------------------------------------------------------------------------------
+ * Stream buffer whose worker thread inflates a `.gz` file ahead of the reader,
+ * so parsing never waits on zlib unless it has caught up with it. A damaged or
+ * truncated file ends early like a shorter one would, `Error` then holds zlib's
+ * message (it is only set once the reader has reached the end).
+ */
+class GzipInputBuffer final : public std::streambuf
+{
+public:
+    explicit GzipInputBuffer(const std::string &file_path);
+    ~GzipInputBuffer() override;
+
+    bool IsOpen() const { return m_file != nullptr; }
+    const std::string& Error() const { return m_error; }
+protected:
+    int_type underflow() override;
+private:
+    void Decompress();
+
+    gzFile m_file{nullptr};
+    std::string m_chunk;
+    ChunkQueue m_queue;
+    std::thread m_worker;
+    std::string m_error;
+};
+
+/* Stream wrappers owning their gzip buffers, used like `std::ofstream` / `std::ifstream` */
+class GzipOfstream final : public std::ostream
+{
+public:
+    explicit GzipOfstream(const std::string &file_path) : std::ostream(&m_buffer), m_buffer(file_path)
+    {
+        if (!m_buffer.IsOpen()) setstate(std::ios::failbit);
+    }
+
+    void close() { if (!m_buffer.Close()) setstate(std::ios::badbit); }
+private:
+    GzipOutputBuffer m_buffer;
+};
+
+class GzipIfstream final : public std::istream
+{
+public:
+    explicit GzipIfstream(const std::string &file_path) : std::istream(&m_buffer), m_buffer(file_path)
+    {
+        if (!m_buffer.IsOpen()) setstate(std::ios::failbit);
+    }
+
+    /* Once the stream is read to its end: sets badbit and returns false if the file ended in an error */
+    bool CheckEnd()
+    {
+        if (!m_buffer.Error().empty()) setstate(std::ios::badbit);
+        return m_buffer.Error().empty();
+    }
+
+    const std::string& Error() const { return m_buffer.Error(); }
+private:
+    GzipInputBuffer m_buffer;
+};
+
+#endif //GZIPSTREAM_H
@@ -4,167 +4,128 @@
 
 #include "taskpch.h"
 #include "Manager.h"
+#include "GzipStream.h"
+#include "OutputBuffer.h"
+#include "ColumnWidths.h"
+#include "StoreFile.h"
+#include "CommandRegistry.h"
+#include "TaskQuery.h"
 
 /* --------------------Consts-------------------- */
 
 using json = nlohmann::json;
 
 static constexpr size_t HISTORY_LIMIT = 50;
+static constexpr auto CONFIG_FILE = "config.json";
+static constexpr auto STORE_FILE = "tasks.db";
+static constexpr auto ARCHIVE_FILE = "tasks.archive";
 static constexpr char TAG_DELIMITER = '|';
 
 static constexpr std::array<int, 12> days_in_month = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 /* --------------------Constructor-------------------- */
 
-Manager::Manager()
+// Config and store are loaded lazily, by the first command that needs them
+Manager::Manager(std::ostream& out, std::ostream& err) : m_out(out), m_err(err)
 {
-    LoadConfig();
+    PushHistory();
 }
 
-/* --------------------Getters-------------------- */
+Manager::~Manager()
+{
+    // Whatever the persistence thread still has queued is committed before the tasks go away
+    if (m_store_writer && !m_store_writer->WaitDurable(m_store_sequence)) {
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to save the task store `" << STORE_FILE << "`!\n";
+    }
+}
 
-inline Command Manager::GetCommand(const std::string& command_str)
-{
-    static const std::unordered_map<std::string, Command> command_map {
-            {"add", Command::Add},      {"a", Command::Add},
-            {"list", Command::List},    {"ls", Command::List},
-            {"edit", Command::Edit},    {"e", Command::Edit},
-            {"delete", Command::Delete},{"rm", Command::Delete},
-            {"complete", Command::Complete},{"c", Command::Complete},
-            {"search", Command::Search},{"s", Command::Search},
-            {"filter", Command::Filter},{"f", Command::Filter},
-            {"sort", Command::Sort},    {"sr", Command::Sort},
-            {"tag", Command::Tag},      {"t", Command::Tag},
-            {"undo", Command::Undo},    {"u", Command::Undo},
-            {"export", Command::Export},{"exp", Command::Export},
-            {"import", Command::Import},{"imp", Command::Import},
-            {"config", Command::Config},{"cfg", Command::Config},
-            {"help", Command::Help},    {"h", Command::Help},
-            {"exit", Command::Exit},    {"q", Command::Exit}
-    };
+/* --------------------Getters-------------------- */
 
-    if (const auto it = command_map.find(command_str); it != command_map.end())
-        return it->second;
-
-    return Command::None;
-}
-
-inline Flag Manager::GetFlag(const std::string& flag_str)
-{
-    static const std::unordered_map<std::string, Flag> flag_map {
-            {"description", Flag::Description}, {"d", Flag::Description},
-            {"priority", Flag::Priority},       {"p", Flag::Priority},
-            {"due", Flag::Due},                 {"du", Flag::Due},
-            {"to", Flag::To},                   {"t", Flag::To},
-            {"tags", Flag::Tags},               {"tg", Flag::Tags},
-            {"id", Flag::ID},                   {"i", Flag::ID},
-            {"by", Flag::SortBy},               {"b", Flag::SortBy},
-            {"order", Flag::SortOrder},         {"o", Flag::SortOrder},
-            {"add", Flag::Add},                 {"a", Flag::Add},
-            {"remove", Flag::Remove},           {"r", Flag::Remove},
-            {"list", Flag::List},               {"l", Flag::List},
-            {"status", Flag::Status},           {"s", Flag::Status},
-            {"file", Flag::File},               {"f", Flag::File},
-            {"default-priority", Flag::DefaultPriority}, {"dp", Flag::DefaultPriority}
-    };
+inline Command Manager::GetCommand(const std::string_view command_str)
+{
+    return LookupCommand(command_str);
+}
 
-    if (const auto it = flag_map.find(flag_str); it != flag_map.end())
-        return it->second;
+inline Flag Manager::GetFlag(const std::string_view flag_str)
+{
+    return LookupFlag(flag_str);
+}
 
-    return Flag::None;
+// The value tables are a handful of entries long, a linear scan beats hashing the key
+template <typename Value, size_t N>
+static Value FindValue(const std::array<std::pair<std::string_view, Value>, N>& table, const std::string_view key, const Value fallback)
+{
+    const auto it = std::ranges::find(table, key, &std::pair<std::string_view, Value>::first);
+    return it != table.end() ? it->second : fallback;
 }
 
-inline Priority Manager::GetPriority(const std::string& priority_str)
+inline Priority Manager::GetPriority(const std::string_view priority_str)
 {
-    static const std::unordered_map<std::string, Priority> priority_map {
+    static constexpr std::array<std::pair<std::string_view, Priority>, 4> priority_table {{
         {"high", Priority::High},
         {"medium", Priority::Medium},
         {"low", Priority::Low},
         {"none", Priority::None}
-    };
+    }};
 
-    if (const auto it = priority_map.find(priority_str); it != priority_map.end())
-        return it->second;
-
-    return Priority::Invalid;
+    return FindValue(priority_table, priority_str, Priority::Invalid);
 }
 
-inline Status Manager::GetStatus(const std::string& status_str)
+inline Status Manager::GetStatus(const std::string_view status_str)
 {
-    static const std::unordered_map<std::string, Status> status_map {
+    static constexpr std::array<std::pair<std::string_view, Status>, 2> status_table {{
         {"completed", Status::Completed},
         {"pending", Status::Pending}
-    };
+    }};
 
-    if (const auto it = status_map.find(status_str); it != status_map.end())
-        return it->second;
-
-    return Status::None;
+    return FindValue(status_table, status_str, Status::None);
 }
 
-inline Order Manager::GetOrder(const std::string& order_str)
+inline Order Manager::GetOrder(const std::string_view order_str)
 {
-    static const std::unordered_map<std::string, Order> order_map {
+    static constexpr std::array<std::pair<std::string_view, Order>, 2> order_table {{
             {"asc", Order::Ascending},
             {"desc", Order::Descending}
-    };
+    }};
+
+    return FindValue(order_table, order_str, Order::None);
+}
 
-    if (const auto it = order_map.find(order_str); it != order_map.end())
-        return it->second;
+inline ImportMode Manager::GetImportMode(const std::string_view mode_str)
+{
+    static constexpr std::array<std::pair<std::string_view, ImportMode>, 3> mode_table {{
+            {"skip", ImportMode::Skip},
+            {"upsert", ImportMode::Upsert},
+            {"replace", ImportMode::Replace}
+    }};
 
-    return Order::None;
+    return FindValue(mode_table, mode_str, ImportMode::None);
 }
 
 /* --------------------Converters-------------------- */
 
-inline std::string Manager::GetPriorityStr(const Priority &priority)
+inline std::string_view Manager::GetPriorityStr(const Priority &priority)
 {
-    static const std::unordered_map<Priority, std::string> priority_str_map {
-        {Priority::High, "high"},
-        {Priority::Medium, "medium"},
-        {Priority::Low, "low"},
-        {Priority::None, "none"}
-    };
-
-    if (const auto it = priority_str_map.find(priority); it != priority_str_map.end())
-        return it->second;
-
-    return "invalid";
+    return priority_names[static_cast<size_t>(priority)];
 }
 
 inline std::string Manager::GetFlagStr(const Flag &flag)
 {
-    static const std::unordered_map<Flag, std::string> flag_str_map {
-        {Flag::Description, "description"},
-        {Flag::Priority, "priority"},
-        {Flag::Due, "due"},
-        {Flag::To, "to"},
-        {Flag::Tags, "tags"},
-        {Flag::ID, "id"},
-        {Flag::SortBy, "by"},
-        {Flag::SortOrder, "order"},
-        {Flag::Add, "add"},
-        {Flag::Remove, "remove"},
-        {Flag::List, "list"},
-        {Flag::Status, "status"},
-        {Flag::File, "file"},
-        {Flag::DefaultPriority, "default-priority"}
-    };
-
-    if (const auto it = flag_str_map.find(flag); it != flag_str_map.end())
-        return it->second;
+    if (flag == Flag::None) return "none";
 
-    return "none";
+    return std::string(GetFlagSpec(flag).name);
 }
 
 /* --------------------Helpers-------------------- */
 
-DateValidationResult Manager::ValidateDateFormat(std::string &date)
+DateValidationResult Manager::ValidateDateFormat(auto &date)
 {
-    const std::regex date_format(R"(^(\d{4})([-/\.])(\d{1,2})\2(\d{1,2})$)");
+    // Compiled once per process instead of once per validated date
+    static const std::regex date_format(R"(^(\d{4})([-/\.])(\d{1,2})\2(\d{1,2})$)");
 
-    std::smatch match;
-    if (!std::regex_match(date, match, date_format))
+    const std::string_view text = date;
+    std::match_results<std::string_view::const_iterator> match;
+    if (!std::regex_match(text.begin(), text.end(), match, date_format))
         return DateValidationResult::InvalidFormat;
 
     // Get year, month, day
@@ -187,37 +148,43 @@ DateValidationResult Manager::ValidateDateFormat(std::string &date)
     return DateValidationResult::Success;
 }
 
-bool Manager::ValidateAddTags(const std::vector<std::string>& values, Task& task)
+bool Manager::ValidateAddTags(const FlagValues& values, Task& task)
 {
     std::unordered_set<std::string> unique_values;
 
     for (auto &tag : values) {
         if (tag.find(TAG_DELIMITER) != std::string::npos) {
-            std::cerr << "❌ Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER;
+            Fail(m_err) << Icon("❌ ") << "Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER;
+            return false;
+        }
+        if (tag.size() > StoreFile::MAX_TAG_BYTES) {
+            Fail(m_err) << Icon("❌ ") << "Error: A tag can be at most " << StoreFile::MAX_TAG_BYTES << " bytes long!\n";
             return false;
         }
-        unique_values.insert(tag);
-        m_tags.try_emplace(tag, 0).first->second++;
+        unique_values.emplace(tag);
     }
 
-    task.tags.assign(unique_values.begin(), unique_values.end());
+    m_tasks.SetTags(task, unique_values);
     return true;
 }
 
-bool Manager::ValidateEditTags(const std::vector<std::string>& values, const auto& it)
+bool Manager::ValidateEditTags(const FlagValues& values, const auto& it)
 {
     std::unordered_set<std::string> unique_values;
 
     for (auto &tag : values) {
         if (tag.find(TAG_DELIMITER) != std::string::npos) {
-            std::cerr << "❌ Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER;
+            Fail(m_err) << Icon("❌ ") << "Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER;
             return false;
         }
-        unique_values.insert(tag);
-        m_tags.try_emplace(tag, 0).first->second++;
+        if (tag.size() > StoreFile::MAX_TAG_BYTES) {
+            Fail(m_err) << Icon("❌ ") << "Error: A tag can be at most " << StoreFile::MAX_TAG_BYTES << " bytes long!\n";
+            return false;
+        }
+        unique_values.emplace(tag);
     }
 
-    it->tags.assign(unique_values.begin(), unique_values.end());
+    m_tasks.SetTags(*it, unique_values);
     return true;
 }
 
@@ -228,24 +195,23 @@ inline void Manager::ToLower(std::string& str)
 
 inline bool Manager::FlagUsed(const Flag &flag) const
 {
-    const auto it = m_flags.find(flag);
-    return it != m_flags.end() && !it->second.empty();
+    return m_flags.contains(flag) && !m_flags.at(flag).empty();
 }
 
-inline bool Manager::IsFlag(const std::string& flag)
+inline bool Manager::IsFlag(const std::string_view flag)
 {
     return flag.length() >= 3 && flag.starts_with("--");
 }
 
-inline void Manager::PrintExitMessage()
+inline void Manager::PrintExitMessage() const
 {
-    std::cout << "\n============================================\n"
-              << "  ✅ Thank you for using Task Manager CLI! \n"
-              << "     Have a productive day! 🚀  \n"
-              << "============================================\n\n";
+    m_out << "\n============================================\n"
+          << "  " << Icon("✅ ") << "Thank you for using Task Manager CLI! \n"
+          << "     Have a productive day! " << Icon("🚀") << "  \n"
+          << "============================================\n\n";
 }
 
-void Manager::SplitQuotedText(const std::string& input, std::vector<std::string>& output)
+void Manager::SplitQuotedText(const std::string_view input, std::vector<std::string>& output)
 {
     std::string current_arg;
 
@@ -272,7 +238,7 @@ void Manager::SplitQuotedText(const std::string& input, std::vector<std::string>
 void Manager::SortIndirectly()
 {
     if (m_prev_sort.first != Flag::None) {
-        m_flags[Flag::SortBy] = {GetFlagStr(m_prev_sort.first)};
+        m_flags[Flag::SortBy] = {GetFlagSpec(m_prev_sort.first).name};
         m_flags[Flag::SortOrder] = {(m_prev_sort.second == Order::Ascending ? "asc" : "desc")};
         Sort(false);
     }
@@ -280,20 +246,58 @@ void Manager::SortIndirectly()
     m_in_order = true;
 }
 
-void Manager::ListIndirectly()
+void Manager::ListIndirectly(const std::vector<const Task*>& rows)
+{
+    if (rows.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks available.\n";
+        return;
+    }
+
+    RenderTable(rows, m_tasks);
+}
+
+bool Manager::ParseCount(const Flag& flag, size_t& count)
+{
+    const std::string_view value = m_flags[flag][0];
+    const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+
+    if (ec != std::errc() || end != value.data() + value.size()) {
+        PrintInvalidValuesError(GetFlagStr(flag), value, "a non-negative integer");
+        return false;
+    }
+
+    return true;
+}
+
+bool Manager::CompareTasks(const Task& a, const Task& b, const Flag& sort_by)
 {
-    m_hidden_count = std::ranges::count_if(m_tasks, [](const Task& task) { return task.hidden; });
+    switch (sort_by) {
+        case Flag::Priority: return static_cast<int>(a.priority) < static_cast<int>(b.priority);
+        case Flag::Due:      return a.due < b.due;
+        case Flag::ID:       return a.id < b.id;
+        default:             return static_cast<int>(a.status) < static_cast<int>(b.status);
+    }
+}
 
-    List(false);
+void Manager::PartialSortRows(std::vector<const Task*>& rows, const size_t count, const Flag& sort_by, const Order& order)
+{
+    // Ties are broken by position in `m_tasks`, which gives the same order as `stable_sort` (+ `reverse`)
+    const auto less = [&sort_by, &order](const Task* a, const Task* b) {
+        if (order == Order::Descending) std::swap(a, b);
+        if (CompareTasks(*a, *b, sort_by)) return true;
+        if (CompareTasks(*b, *a, sort_by)) return false;
+        return a < b;
+    };
 
-    std::ranges::for_each(m_tasks, [](Task& task) { task.hidden = false; });
-    m_hidden_count = 0;
+    const auto middle = rows.begin() + static_cast<std::ptrdiff_t>(std::min(count, rows.size()));
+    std::partial_sort(rows.begin(), middle, rows.end(), less);
+    rows.erase(middle, rows.end());
 }
 
 void Manager::ListTags() const
 {
     if (m_tags.empty()) {
-        std::cout << "\n📭 No tags available.\n";
+        m_out << "\n" << Icon("📭 ") << "No tags available.\n";
         return;
     }
 
@@ -301,8 +305,8 @@ void Manager::ListTags() const
     size_t max_tag_length = 4;
     std::vector<std::string> tag_list;
 
-    for (const auto& [tag, count] : m_tags) {
-        tag_list.push_back(tag);
+    for (const auto& [tag, postings] : m_tags) {
+        tag_list.emplace_back(tag);
         max_tag_length = std::max(max_tag_length, tag.length());
     }
 
@@ -315,10 +319,10 @@ void Manager::ListTags() const
 
 
     // **Step 2: Print Header**
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
-    std::cout << "|" << std::setw(static_cast<int>(table_width / 2) + 1) << std::right << "Tags"
-              << std::setw(static_cast<int>(table_width / 2) - 1 - (table_width % 2 == 0)) << std::right << "|" << "\n";
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
+    m_out << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
+    m_out << "|" << std::setw(static_cast<int>(table_width / 2) + 1) << std::right << "Tags"
+          << std::setw(static_cast<int>(table_width / 2) - 1 - (table_width % 2 == 0)) << std::right << "|" << "\n";
+    m_out << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
 
     // **Step 3: Print Tags in Columns**
     size_t index = 0;
@@ -326,23 +330,23 @@ void Manager::ListTags() const
     for (size_t row = 0; row < num_rows; ++row) {
         for (size_t col = 0; col < num_columns; ++col) {
             if (index < tag_count) {
-                std::cout << "| " << std::setw(static_cast<int>(max_tag_length)) << std::left << tag_list[index++];
+                m_out << "| " << std::setw(static_cast<int>(max_tag_length)) << std::left << tag_list[index++];
             } else {
-                std::cout << "| " << std::setw(static_cast<int>(max_tag_length)) << " "; // Empty slot
+                m_out << "| " << std::setw(static_cast<int>(max_tag_length)) << " "; // Empty slot
             }
         }
-        std::cout << "|\n";
+        m_out << "|\n";
     }
 
     // **Step 4: Print Bottom Border**
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
+    m_out << std::setfill('-') << std::setw(static_cast<int>(table_width)) << "" << std::setfill(' ') << "\n";
 }
 
-bool Manager::AddFlagUpdate(const Flag& flag, std::vector<std::string>& values, Task& task)
+bool Manager::AddFlagUpdate(const Flag& flag, const FlagValues& values, Task& task)
 {
     switch (flag) {
         case Flag::Description:
-            task.description = values[0];
+            m_tasks.SetDescription(task, values[0]);
             return true;
 
         case Flag::Priority:
@@ -353,8 +357,9 @@ bool Manager::AddFlagUpdate(const Flag& flag, std::vector<std::string>& values,
             }
             return true;
 
-        case Flag::Due:
-            switch (ValidateDateFormat(values[0])) {
+        case Flag::Due: {
+            std::string due(values[0]);
+            switch (ValidateDateFormat(due)) {
                 case DateValidationResult::InvalidFormat:
                     PrintInvalidValuesError("due", values[0], "Format: `YYYY-MM-DD`, `YYYY.MM.DD`, `YYYY/MM/DD`");
                     return false;
@@ -362,26 +367,27 @@ bool Manager::AddFlagUpdate(const Flag& flag, std::vector<std::string>& values,
                     PrintInvalidValuesError("due", values[0], "Real day in a calendar starting from (1900-01-01)");
                     return false;
                 default:
-                    task.due = values[0];
+                    task.due = PackDate(due);
                     return true;
             }
+        }
 
         case Flag::Tags:
             return ValidateAddTags(values, task);
 
         default:
-            PrintInvalidFlagsError("add", {"description", "priority", "due", "tags"});
+            PrintInvalidFlagsError(Command::Add);
             return false;
     }
 }
 
-bool Manager::EditFlagUpdate(const Flag& flag, std::vector<std::string>& values, const auto& it)
+bool Manager::EditFlagUpdate(const Flag& flag, const FlagValues& values, const auto& it)
 {
     if (flag == Flag::ID) return true;
 
     switch (flag) {
         case Flag::Description:
-            it->description = values[0];
+            m_tasks.SetDescription(*it, values[0]);
             return true;
 
         case Flag::Priority:
@@ -392,8 +398,9 @@ bool Manager::EditFlagUpdate(const Flag& flag, std::vector<std::string>& values,
             }
             return true;
 
-        case Flag::Due:
-            switch (ValidateDateFormat(values[0])) {
+        case Flag::Due: {
+            std::string due(values[0]);
+            switch (ValidateDateFormat(due)) {
                 case DateValidationResult::InvalidFormat:
                     PrintInvalidValuesError("due", values[0], "Format: `YYYY-MM-DD`, `YYYY.MM.DD`, `YYYY/MM/DD`");
                     return false;
@@ -401,16 +408,12 @@ bool Manager::EditFlagUpdate(const Flag& flag, std::vector<std::string>& values,
                     PrintInvalidValuesError("due", values[0], "Real day in a calendar starting from (1900-01-01)");
                     return false;
                 default:
-                    it->due = values[0];
+                    it->due = PackDate(due);
                     return true;
             }
+        }
 
         case Flag::Tags:
-            for (auto &tag : it->tags) {
-                if (--m_tags[tag] == 0) {
-                    m_tags.erase(tag);
-                }
-            }
             return ValidateEditTags(values, it);
 
         case Flag::Status:
@@ -423,379 +426,983 @@ bool Manager::EditFlagUpdate(const Flag& flag, std::vector<std::string>& values,
             return true;
 
         default:
-            PrintInvalidFlagsError("edit", {"description", "priority", "due", "tags", "status"});
+            PrintInvalidFlagsError(Command::Edit);
             return false;
     }
 }
 
 void Manager::AddToHistory()
 {
+    m_store_changed = true;
+    if (m_one_shot) return;
+
+    // A batch is committed as a single history entry by `EndBatch`
+    if (m_in_batch) {
+        m_batch_changed = true;
+        return;
+    }
+
     // Push to history
     if (history.size() >= HISTORY_LIMIT) { history.pop_front(); }
-    history.emplace_back(m_tasks);
+    PushHistory();
 }
 
-void Manager::LoadConfig()
+void Manager::PushHistory()
 {
-    std::ifstream file("config.json");
-
-    if (file) {
-        file >> config;
-        std::string default_priority = config["default_priority"];
-        ToLower(default_priority);
-        config["default_priority"] = default_priority;
-    } else {
-        config["default_priority"] = "none";
-        SaveConfig();
-    }
+    // Entries are shared with the persistence thread, the one that drops the last reference frees the copy
+    history.push_back(std::allocate_shared<TaskTable>(std::pmr::polymorphic_allocator<TaskTable>(&m_history_memory), m_tasks));
 }
 
-void Manager::SaveConfig() const
+void Manager::CompactTasks()
 {
-    std::ofstream file("config.json");
-    file << config.dump(4);
+    // Positions are kept, so the ID index and the tag postings stay valid
+    m_tasks.Compact();
 }
 
-/* --------------------Main Functionality-------------------- */
-
-void Manager::Add()
+TaskTable::iterator Manager::FindTask(const unsigned int id)
 {
-    // Required Tags
-    if (!FlagUsed(Flag::Description)) {
-        PrintArgumentError("--description", "is required for this command.");
-        return;
-    }
+    if (const auto it = m_id_index.find(id); it != m_id_index.end())
+        return m_tasks.begin() + static_cast<std::ptrdiff_t>(it->second);
 
-    Task task;
+    return m_tasks.end();
+}
 
-    // Default Priority
-    task.priority = GetPriority(config["default_priority"]);
+void Manager::IndexTask(const Task& task)
+{
+    IndexTask(task, m_tasks);
+}
 
-    // Update the other flags
-    for (auto &[flag, values] : m_flags) {
-        if (!AddFlagUpdate(flag, values, task)) {
-            return;
-        }
+void Manager::IndexTask(const Task& task, const TaskTable& tasks)
+{
+    for (const auto tag : tasks.Tags(task)) {
+        m_tags[std::pmr::string(tag)].insert(task.id);
     }
 
-    // Give ID
-    task.id = m_prev_id++;
-
-    // Add the task
-    m_tasks.push_back(task);
-
-    m_in_order = false;
-    std::cout << "📌 Task added successfully! (ID: " << task.id << ")\n";
-
-    // Add to history for undo
-    AddToHistory();
+    m_widths.Add(task, tasks);
+    m_pending.Add(task);
+    m_counters.Add(task);
 }
 
-void Manager::List(const bool called_directly)
+void Manager::UnindexTask(const Task& task)
 {
-    if (!m_flags.empty() && called_directly) {
-        PrintArgumentError("no flags", "are allowed for this command.");
-        return;
+    for (const auto tag : m_tasks.Tags(task)) {
+        const auto it = m_tags.find(std::pmr::string(tag));
+        if (it != m_tags.end() && it->second.erase(task.id) == 1 && it->second.empty()) m_tags.erase(it);
     }
 
-    if (m_tasks.empty() || m_tasks.size() == m_hidden_count) {
-        std::cout << "\n📭 No tasks available.\n";
-        return;
-    }
+    m_widths.Remove(task, m_tasks);
+    m_pending.Remove(task.id);
+    m_counters.Remove(task);
+}
 
-    if (!m_in_order) SortIndirectly();
+/* --------------------Task Selection-------------------- */
 
-    // **Step 1: Compute Column Widths Dynamically**
-    size_t id_width = 4;
-    size_t desc_width = 11;
-    size_t due_width = 9;
-    size_t priority_width = 8;
-    size_t status_width = 7;
-    size_t tags_width = 4;
+bool Manager::ParseSelection(TaskQuery& query)
+{
+    if (!FlagUsed(Flag::ID) && !FlagUsed(Flag::Where)) {
+        PrintArgumentError("--id / --where", "is required for this command.");
+        return false;
+    }
 
-    for (const auto& task : m_tasks) {
-        if (task.hidden) continue;
+    return ParseIdRanges(query) && ParseWhere(query);
+}
 
-        id_width = std::max(id_width, std::to_string(task.id).length());
-        desc_width = std::max(desc_width, task.description.length());
-        due_width = std::max(due_width, task.due.length());
-        priority_width = std::max(priority_width, GetPriorityStr(task.priority).length());
-        status_width = std::max(status_width, static_cast<size_t>(task.status == Status::Pending ? 8 : 9));
+bool Manager::ParseIdRanges(TaskQuery& query)
+{
+    if (!FlagUsed(Flag::ID)) return true;
 
-        size_t tag_length = 0;
+    const auto parse_id = [](const std::string_view text, unsigned int& id) {
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), id);
+        return ec == std::errc() && end == text.data() + text.size()
+            && id <= std::numeric_limits<decltype(Task::id)>::max();
+    };
 
-        if (!task.tags.empty()) {
-            const size_t total_tag_chars = std::accumulate(
-                task.tags.begin(), task.tags.end(), 0,
-                [](const size_t sum, const std::string& tag) { return sum + tag.length(); });
+    std::vector<IdRange> ranges;
+    for (const std::string_view value : m_flags[Flag::ID]) {
+        const size_t dash = value.find('-', 1);
+        IdRange range;
 
-            const size_t num_commas = 2 * (task.tags.size() - 1); // Space for ", " between tags
+        bool valid;
+        if (dash == std::string_view::npos) {
+            valid = parse_id(value, range.first);
+            range.last = range.first;
+        } else {
+            valid = parse_id(value.substr(0, dash), range.first) && parse_id(value.substr(dash + 1), range.last)
+                && range.first <= range.last;
+        }
 
-            tag_length = total_tag_chars + num_commas;
+        if (!valid) {
+            PrintInvalidValuesError("id", value, "a positive integer or an ascending range such as `9-200`");
+            return false;
         }
 
-        tags_width = std::max(tags_width, tag_length);
+        ranges.push_back(range);
     }
 
-    // Add some padding for readability
-    id_width += 2;
-    desc_width += 2;
-    due_width += 2;
-    priority_width += 2;
-    status_width += 2;
-    tags_width += 2;
-
-    // **Step 2: Print Header**
-    const size_t total_width = id_width + desc_width + due_width + priority_width + status_width + tags_width + 14;
+    query.AddIds(std::move(ranges));
+    return true;
+}
 
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(total_width)) << "" << std::setfill(' ') << "\n";
+bool Manager::ParseWhere(TaskQuery& query)
+{
+    if (!FlagUsed(Flag::Where)) return true;
 
-    std::cout << std::left
-              << "| " << std::setw(static_cast<int>(id_width)) << "ID"
-              << "| " << std::setw(static_cast<int>(desc_width)) << "Description"
-              << "| " << std::setw(static_cast<int>(due_width)) << "Due Date"
-              << "| " << std::setw(static_cast<int>(priority_width)) << "Priority"
-              << "| " << std::setw(static_cast<int>(status_width)) << "Status"
-              << "| " << std::setw(static_cast<int>(tags_width)) << "Tags"
-              << " |" << "\n";
+    for (const std::string_view text : m_flags[Flag::Where]) {
+        std::string_view field_str, value;
+        QueryCondition condition;
 
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(total_width)) << "" << std::setfill(' ') << "\n";
+        if (!TaskQuery::SplitCondition(text, field_str, condition.op, value)) {
+            PrintInvalidValuesError("where", text, "`field<op>value`, e.g. `status=completed` or `due<2025-01-01`");
+            return false;
+        }
 
-    // **Step 3: Print Each Task**
-    for (const auto& task : m_tasks) {
-        if (task.hidden) continue;
+        condition.field = TaskQuery::GetField(field_str);
+        const bool equality = condition.op == QueryOp::Equal || condition.op == QueryOp::NotEqual;
 
-        std::ostringstream tags_stream;
-        for (size_t i = 0; i < task.tags.size(); ++i) {
-            if (i > 0) tags_stream << ", ";  // Add separator before each new tag (except first)
-            tags_stream << task.tags[i];
+        switch (condition.field) {
+            case QueryField::ID: {
+                const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), condition.number);
+                if (ec != std::errc() || end != value.data() + value.size()) {
+                    PrintInvalidValuesError("where", text, "an integer task ID");
+                    return false;
+                }
+                break;
+            }
+            case QueryField::Status: {
+                const Status status = GetStatus(value);
+                if (status == Status::None || !equality) {
+                    PrintInvalidValuesError("where", text, "`status=` or `status!=` followed by `pending` or `completed`");
+                    return false;
+                }
+                condition.number = static_cast<unsigned int>(status);
+                break;
+            }
+            case QueryField::Priority: {
+                const Priority priority = GetPriority(value);
+                if (priority == Priority::Invalid) {
+                    PrintInvalidValuesError("where", text, "`high`, `medium`, `low`, or `none` (ordered none < low < medium < high)");
+                    return false;
+                }
+                condition.number = static_cast<unsigned int>(priority);
+                break;
+            }
+            case QueryField::Due: {
+                condition.text = value;
+                if (condition.text == "none") {
+                    if (equality) break;
+                    PrintInvalidValuesError("where", text, "`due=none` or `due!=none` for tasks without a due date");
+                    return false;
+                }
+                if (ValidateDateFormat(condition.text) != DateValidationResult::Success) {
+                    PrintInvalidValuesError("where", text, "a real date, Format: `YYYY-MM-DD`, `YYYY.MM.DD`, `YYYY/MM/DD`");
+                    return false;
+                }
+                condition.number = PackDate(condition.text);
+                break;
+            }
+            case QueryField::Tag:
+                if (!equality) {
+                    PrintInvalidValuesError("where", text, "`tag=` or `tag!=` followed by a tag");
+                    return false;
+                }
+                condition.text = value;
+                break;
+            default:
+                PrintInvalidValuesError("where", text, "a condition on `id`, `status`, `priority`, `due` or `tag`");
+                return false;
         }
 
-        std::cout << std::left
-                  << "| " << std::setw(static_cast<int>(id_width)) << task.id
-                  << "| " << std::setw(static_cast<int>(desc_width)) << task.description
-                  << "| " << std::setw(static_cast<int>(due_width)) << task.due
-                  << "| " << std::setw(static_cast<int>(priority_width)) << GetPriorityStr(task.priority)
-                  << "| " << std::setw(static_cast<int>(status_width)) << (task.status == Status::Pending ? "Pending" : "Completed")
-                  << "| " << std::setw(static_cast<int>(tags_width)) << tags_stream.str()
-                  << " |" << "\n";
+        query.AddCondition(std::move(condition));
     }
 
-    // **Step 4: Print Bottom Line**
-    std::cout << std::setfill('-') << std::setw(static_cast<int>(total_width)) << "" << std::setfill(' ') << "\n";
+    return true;
 }
 
-void Manager::Edit()
+bool Manager::SelectTasks(const TaskQuery& query, std::vector<size_t>& positions)
 {
-    // Required flags
-    if (!FlagUsed(Flag::ID)) {
-        PrintArgumentError("--id", "is required for this command.");
-        return;
-    }
-
-    // No changes specified
-    if (m_flags.size() == 1) {
-        std::cout << "❌ Error: No changes specified. Use other flags (e.g., --description, --priority, --due, --tags, --status) along with --id.\n";
-        return;
-    }
-
-
-    try {
-        if (!m_flags[Flag::ID][0].empty() && m_flags[Flag::ID][0][0] == '-') {
-            PrintInvalidValuesError("id", m_flags[Flag::ID][0], "must be a positive integer.");
-            return;
+    // A short list of IDs is resolved through the index, anything wider is a single pass over the tasks
+    if (query.HasIds() && query.IdSpan() < m_tasks.size()) {
+        m_metrics.rows_scanned += query.IdSpan();
+        for (const auto &[first, last] : query.Ids()) {
+            // No ID past `m_prev_id` has been handed out, and a 64-bit counter cannot wrap at the top of the range
+            const std::uint64_t end = std::min<std::uint64_t>(last, m_prev_id);
+            for (std::uint64_t id = first; id <= end; id++) {
+                const auto it = m_id_index.find(static_cast<unsigned int>(id));
+                if (it != m_id_index.end() && query.Matches(m_tasks[it->second], m_tasks)) positions.push_back(it->second);
+            }
         }
-
-        const unsigned short int id = std::stoi(m_flags[Flag::ID][0]);
-        const auto it = std::ranges::find_if(m_tasks.begin(), m_tasks.end(),
-            [id](const Task& task) { return task.id == id; });
-
-        if (it == m_tasks.end()) {
-            return PrintTaskNotFoundError(m_flags[Flag::ID][0]);
+        std::ranges::sort(positions);
+    } else {
+        m_metrics.rows_scanned += m_tasks.size();
+        for (size_t i = 0; i < m_tasks.size(); i++) {
+            if (query.Matches(m_tasks[i], m_tasks)) positions.push_back(i);
         }
+    }
 
-        for (auto& [flag, values] : m_flags) {
-            if (!EditFlagUpdate(flag, values, it)) {
-                return;
-            }
-        }
+    if (!positions.empty()) return true;
 
-        m_in_order = false;
-        std::cout << "✏️  Task (ID: " << it->id << ") updated successfully!\n";
+    // A lone ID keeps the familiar error, a wider selection may legitimately match nothing
+    if (query.IdSpan() == 1 && !FlagUsed(Flag::Where))
+        PrintTaskNotFoundError(m_flags[Flag::ID][0]);
+    else
+        m_out << Icon("📭 ") << "No tasks match the selection.\n";
 
-        AddToHistory();
-    } catch (const std::exception&) {
-        PrintInvalidValuesError("id", m_flags[Flag::ID][0], "integer");
-    }
+    return false;
 }
 
-void Manager::Delete()
+void Manager::LoadStore()
 {
-    // Required flags
-    if (!FlagUsed(Flag::ID)) {
-        PrintArgumentError("--id", "is required for this command.");
+    if (m_store_loaded) return;
+    m_store_loaded = true;
+
+    if (m_paged) {
+        // Every page is indexed as it is read, the pool keeps as many of them as it has room for
+        const bool opened = m_paged->Open(STORE_FILE, m_prev_id, [this](const TaskTable& page, const size_t first) {
+            for (size_t i = 0; i < page.size(); i++) {
+                m_id_index.emplace(page[i].id, first + i);
+                IndexTask(page[i], page);
+            }
+        });
+
+        if (!opened) {
+            Fail(m_err) << Icon("❌ ") << "Error: The task store `" << STORE_FILE << "` is damaged, no task can be read.\n";
+            m_store_damaged = true;
+            RebuildIndexes();
+        }
         return;
     }
 
-    // Wrong flags
-    if (m_flags.size() > 1) {
-        PrintInvalidFlagsError("delete", {"id"});
+    if (!StoreFile::Load(STORE_FILE, m_tasks, m_prev_id)) {
+        Fail(m_err) << Icon("❌ ") << "Error: The task store `" << STORE_FILE << "` is damaged, changes made now will not be saved.\n";
+        m_store_damaged = true;
         return;
     }
 
-    try {
-        if (!m_flags[Flag::ID][0].empty() && m_flags[Flag::ID][0][0] == '-') {
-            PrintInvalidValuesError("id", m_flags[Flag::ID][0], "must be a positive integer.");
-            return;
-        }
+    std::error_code ec;
+    if (const auto size = std::filesystem::file_size(STORE_FILE, ec); !ec) m_metrics.bytes_read += size;
 
-        const unsigned short int id = std::stoi(m_flags[Flag::ID][0]);
-        if (const auto it = std::ranges::find_if(m_tasks.begin(), m_tasks.end(),
-            [id](const Task& task) { return task.id == id; }); it != m_tasks.end()) {
-            for (auto &tag : it->tags) {
-                if (--m_tags[tag] == 0) {
-                    m_tags.erase(tag);
-                }
-            }
-            m_tasks.erase(it);
-            std::cout << "🗑️  Task (ID: " << id << ") deleted successfully!\n";
+    RebuildIndexes();
+    AutoArchive();
 
-            AddToHistory();
-        } else {
-            PrintTaskNotFoundError(m_flags[Flag::ID][0]);
-        }
-    } catch (const std::exception&) {
-        PrintInvalidValuesError("id", m_flags[Flag::ID][0], "integer");
+    // A one-shot process keeps no undo history, so the loaded tasks are not copied into it
+    if (!m_one_shot) {
+        history.clear();
+        PushHistory();
     }
 }
 
-void Manager::Complete()
+void Manager::SaveStore()
 {
-    // Required flags
-    if (!FlagUsed(Flag::ID)) {
-        PrintArgumentError("--id", "is required for this command.");
+    if (m_store_damaged) return;
+
+    // The process exits right after a one-shot command, so there is nothing to overlap the write with
+    if (m_one_shot) {
+        if (m_store_changed && !StoreFile::Save(STORE_FILE, m_tasks, m_prev_id)) {
+            Fail(m_err) << Icon("❌ ") << "Error: Unable to save the task store `" << STORE_FILE << "`!\n";
+        } else if (m_store_changed) {
+            std::error_code ec;
+            if (const auto size = std::filesystem::file_size(STORE_FILE, ec); !ec) m_metrics.bytes_written += size;
+        }
+        m_store_changed = false;
         return;
     }
 
-    // Wrong flags
-    if (m_flags.size() > 1) {
-        PrintInvalidFlagsError("complete", {"id"});
-        return;
+    if (m_store_changed) {
+        if (!m_store_writer) m_store_writer = std::make_unique<StoreWriter>(STORE_FILE);
+
+        // Every change that reaches here went through the history, whose newest entry is the tasks as they are now
+        m_store_sequence = m_store_writer->Submit(history.back(), m_prev_id);
+        m_store_changed = false;
     }
 
-    try {
-        if (!m_flags[Flag::ID][0].empty() && m_flags[Flag::ID][0][0] == '-') {
-            PrintInvalidValuesError("id", m_flags[Flag::ID][0], "must be a positive integer.");
+    if (!m_store_writer) return;
+
+    if (m_sync_requested) {
+        if (!m_store_writer->WaitDurable(m_store_sequence)) {
+            Fail(m_err) << Icon("❌ ") << "Error: Unable to save the task store `" << STORE_FILE << "`!\n";
             return;
         }
 
-        const unsigned short int id = std::stoi(m_flags[Flag::ID][0]);
-        if (const auto it = std::ranges::find_if(m_tasks.begin(), m_tasks.end(),
-            [id](const Task& task) { return task.id == id; }); it != m_tasks.end()) {
-            it->status = Status::Completed;
-            std::cout << "✅ Task (ID: " << id << ") marked as completed!\n";
-
-            AddToHistory();
-        } else {
-            PrintTaskNotFoundError(m_flags[Flag::ID][0]);
-        }
-    } catch (const std::exception&) {
-        PrintInvalidValuesError("id", m_flags[Flag::ID][0], "integer");
+        const StoreWriterStats stats = m_store_writer->Stats();
+        m_out << Icon("💾 ") << "Changes are on disk (last commit: " << std::fixed << std::setprecision(2) << stats.last_commit_ms
+              << " ms, average: " << stats.total_commit_ms / static_cast<double>(stats.commits) << " ms over "
+              << stats.commits << " commit(s) of " << stats.committed << " change(s), queue depth: "
+              << stats.queue_depth << ", max: " << stats.max_queue_depth << ")\n" << std::defaultfloat;
+    } else if (m_store_writer->TakeFailure()) {
+        // A background commit failed: reported on the next command, the following commit retries with every change
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to save the task store `" << STORE_FILE << "`!\n";
     }
 }
 
-void Manager::Search()
+void Manager::UsePagedStore(const size_t pool_pages)
 {
-    const bool description_present = FlagUsed(Flag::Description);
-    const bool tags_present = FlagUsed(Flag::Tags);
+    m_paged = std::make_unique<PagedStore>(pool_pages, &m_pool_memory);
+}
 
-    if (!description_present && !tags_present) {
-        return PrintArgumentError("--description / --tags", "should be present.");
+bool Manager::RunsPaged(const Command command)
+{
+    switch (command) {
+        case Command::List:
+        case Command::Search:
+        case Command::Filter:
+        case Command::Next:
+        case Command::Report:
+        case Command::Export:
+        case Command::Config:
+        case Command::Stats:
+        case Command::Help:
+        case Command::Exit:
+        case Command::None:
+            return true;
+        default:
+            return false;
     }
+}
 
-    if (m_flags.size() > (description_present + tags_present)) {
-        return PrintInvalidFlagsError("search", {"description", "tags"});
-    }
+bool Manager::RunsPaged(const Command command, const Flag flag)
+{
+    // `list --top` ranks every task at once, the pages are only ever visited in store order
+    return RunsPaged(command) && !(command == Command::List && flag == Flag::Top);
+}
 
-    std::ranges::for_each(m_tasks, [](Task& task) { task.hidden = true; });
+void Manager::ReindexFrom(const size_t position)
+{
+    for (size_t i = position; i < m_tasks.size(); i++) {
+        m_id_index[m_tasks[i].id] = i;
+    }
+}
 
-    if (description_present) {
-        std::vector<std::string> keywords;
-        SplitQuotedText(m_flags[Flag::Description][0], keywords);
+void Manager::RebuildIndexes()
+{
+    m_id_index.clear();
+    m_tags.clear();
+    m_widths.Clear();
+    m_pending.Clear();
+    m_counters.Clear();
 
-        for (auto &task : m_tasks) {
-            std::string description = task.description;
-            ToLower(description);
+    for (size_t i = 0; i < m_tasks.size(); i++) {
+        m_id_index.emplace(m_tasks[i].id, i);
+        IndexTask(m_tasks[i]);
+    }
+}
 
-            const bool has_any_occurrences = std::ranges::any_of(keywords,
-                [&description](const std::string& keyword) {
-                    return description.find(keyword) != std::string::npos;
-                });
+bool Manager::UpdateTaskFields(Task& task, const Task& imported, const TaskTable& source)
+{
+    bool changed = false;
+    UnindexTask(task);
 
-            if (has_any_occurrences)
-                task.hidden = false;
-        }
+    if (const std::string_view description = source.Description(imported); m_tasks.Description(task) != description) {
+        m_tasks.SetDescription(task, description);
+        changed = true;
     }
 
-    if (tags_present) {
-        std::vector<std::string> required_tags = m_flags[Flag::Tags];
+    if (task.due != imported.due)           { task.due = imported.due; changed = true; }
+    if (task.priority != imported.priority) { task.priority = imported.priority; changed = true; }
+    if (task.status != imported.status)     { task.status = imported.status; changed = true; }
 
-        for (auto &task : m_tasks) {
-            const bool has_any_tag = std::ranges::any_of(required_tags,
-                [&task](const std::string& tag) {
-                    return std::ranges::find_if(task.tags,
-                        [&tag](const std::string& task_tag) {
-                            return task_tag == tag;
-                        }) != task.tags.end();
-                });
-
-            if (has_any_tag)
-                task.hidden = false;
-        }
+    if (!std::ranges::is_permutation(m_tasks.Tags(task), source.Tags(imported))) {
+        m_tasks.SetTags(task, source.Tags(imported));
+        changed = true;
     }
 
-    ListIndirectly();
+    IndexTask(task);
+    return changed;
 }
 
-void Manager::Filter()
+ImportSummary Manager::MergeImportedTasks(TaskTable& imported_tasks, const ImportMode mode)
 {
-    const bool status_present = FlagUsed(Flag::Status);
-    const bool priority_present = FlagUsed(Flag::Priority);
-    const bool due_present = FlagUsed(Flag::Due);
-    const bool to_present = FlagUsed(Flag::To);
+    ImportSummary summary;
+
+    if (mode == ImportMode::Replace) {
+        m_tasks.clear();
+        m_id_index.clear();
+        m_tags.clear();
+        m_widths.Clear();
+        m_pending.Clear();
+        m_counters.Clear();
+    }
+
+    // Grown geometrically, an import per file must not copy the whole store each time
+    m_tasks.ReserveFor(imported_tasks);
+    const std::vector<std::uint32_t> tag_map = m_tasks.MapTags(imported_tasks);
+
+    // Single pass over the incoming rows, each one probing the ID index once
+    for (const auto &task : imported_tasks) {
+        if (const auto it = m_id_index.find(task.id); it != m_id_index.end()) {
+            if (mode != ImportMode::Upsert) {
+                summary.skipped++;
+            } else if (UpdateTaskFields(m_tasks[it->second], task, imported_tasks)) {
+                summary.updated++;
+            } else {
+                summary.unchanged++;
+            }
+            continue;
+        }
 
-    if (m_flags.size() > (status_present + priority_present + due_present + to_present)) {
-        PrintInvalidFlagsError("filter", {"status", "priority", "due", "to"});
-        return;
+        m_prev_id = std::max(m_prev_id, static_cast<unsigned int>(task.id + 1));
+        m_id_index.emplace(task.id, m_tasks.size());
+        IndexTask(m_tasks.push_back(task, imported_tasks, tag_map));
+        summary.added++;
     }
 
-    if ((due_present && ((to_present && m_flags.size() > 2) || (!to_present && m_flags.size() > 1)))
-        || (!due_present && m_flags.size() > 1)) {
-        PrintArgumentError("filter", "supports only one filter at a time.");
-        return;
-    }
+    return summary;
+}
 
-    if (status_present) {
-        const Status filter_status = GetStatus(m_flags[Flag::Status][0]);
-        if (filter_status == Status::None) {
-            PrintInvalidValuesError("status", m_flags[Flag::Status][0], "`pending` or `completed`");
+void Manager::LoadConfig()
+{
+    if (m_config_loaded) return;
+    m_config_loaded = true;
+
+    // A missing config just means defaults, the file is only written once a setting changes
+    std::ifstream file(CONFIG_FILE);
+
+    if (file) {
+        file >> config;
+        std::string default_priority = config["default_priority"];
+        ToLower(default_priority);
+        config["default_priority"] = default_priority;
+    } else {
+        config["default_priority"] = "none";
+    }
+}
+
+void Manager::SaveConfig()
+{
+    if (m_in_batch) {
+        m_config_changed = true;
+        return;
+    }
+
+    std::ofstream file(CONFIG_FILE);
+    file << config.dump(4);
+}
+
+/* --------------------Main Functionality-------------------- */
+
+void Manager::Add()
+{
+    // Required Tags
+    if (!FlagUsed(Flag::Description)) {
+        PrintArgumentError("--description", "is required for this command.");
+        return;
+    }
+
+    Task task;
+
+    // Default Priority
+    LoadConfig();
+    task.priority = GetPriority(config["default_priority"].get_ref<const ConfigString&>());
+
+    // Update the other flags
+    for (const auto &[flag, values] : m_flags) {
+        if (!AddFlagUpdate(flag, values, task)) {
+            return;
+        }
+    }
+
+    // Give ID
+    task.id = m_prev_id++;
+
+    // Add the task
+    IndexTask(task);
+    m_id_index.emplace(task.id, m_tasks.size());
+    m_tasks.push_back(task);
+
+    m_in_order = false;
+    m_out << Icon("📌 ") << "Task added successfully! (ID: " << task.id << ")\n";
+
+    // Add to history for undo
+    AddToHistory();
+}
+
+void Manager::List()
+{
+    const bool limit_used = FlagUsed(Flag::Limit);
+    const bool offset_used = FlagUsed(Flag::Offset);
+    const bool top_used = FlagUsed(Flag::Top);
+    const bool by_used = FlagUsed(Flag::SortBy);
+    const bool order_used = FlagUsed(Flag::SortOrder);
+
+    if (m_flags.size() > static_cast<size_t>(limit_used + offset_used + top_used + by_used + order_used)) {
+        PrintInvalidFlagsError(Command::List);
+        return;
+    }
+
+    if (top_used && (limit_used || offset_used)) {
+        PrintArgumentError("--top", "cannot be combined with --limit / --offset.");
+        return;
+    }
+
+    if (top_used != by_used || (order_used && !top_used)) {
+        PrintArgumentError("--top", "must be used together with --by [--order].");
+        return;
+    }
+
+    size_t limit = m_tasks.size();
+    size_t offset = 0;
+
+    if ((limit_used && !ParseCount(Flag::Limit, limit)) || (offset_used && !ParseCount(Flag::Offset, offset))
+        || (top_used && !ParseCount(Flag::Top, limit))) {
+        return;
+    }
+
+    if (m_paged) {
+        if (top_used && !RunsPaged(Command::List, Flag::Top)) {
+            return PrintArgumentError("--top", "needs the tasks in memory, run it without `--pool`.");
+        }
+        return ListPaged(offset, limit_used ? limit : m_paged->size(), !(limit_used || offset_used));
+    }
+
+    if (m_tasks.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks available.\n";
+        return;
+    }
+
+    std::vector<const Task*> rows;
+
+    if (top_used) {
+        // Top-N: O(n + k log k) selection, the store itself is left untouched
+        const Flag sort_by = GetFlag(m_flags[Flag::SortBy][0]);
+        if (sort_by != Flag::Priority && sort_by != Flag::Due && sort_by != Flag::ID && sort_by != Flag::Status) {
+            PrintInvalidValuesError("by", m_flags[Flag::SortBy][0], "`priority`, `due`, `id`, `status`");
+            return;
+        }
+
+        // Top means highest first for priority, earliest / smallest first for everything else
+        const Order default_order = sort_by == Flag::Priority ? Order::Descending : Order::Ascending;
+        const Order order = order_used ? GetOrder(m_flags[Flag::SortOrder][0]) : default_order;
+        if (order == Order::None) {
+            PrintInvalidValuesError("order", m_flags[Flag::SortOrder][0], "`asc`, `desc`");
             return;
         }
 
-        std::ranges::for_each(m_tasks, [filter_status](Task& task) {
-            task.hidden = (task.status != filter_status);
+        m_metrics.rows_scanned += m_tasks.size();
+        rows.reserve(m_tasks.size());
+        for (const auto &task : m_tasks) rows.push_back(&task);
+        PartialSortRows(rows, limit, sort_by, order);
+    } else if (!(limit_used || offset_used)) {
+        // Full listing: the layout is maintained by the store, so rows are written in a single pass
+        if (!m_in_order) SortIndirectly();
+
+        const TableLayout layout = m_widths.Layout();
+        m_metrics.rows_scanned += m_tasks.size();
+        m_metrics.rows_returned += m_tasks.size();
+
+        RenderHeader(layout);
+        for (const auto &task : m_tasks) RenderRow(task, m_tasks, layout);
+        RenderFooter(layout);
+        return;
+    } else if (m_in_order || m_prev_sort.first == Flag::None) {
+        // The store already follows the active sort (or is about to), so a page is a plain O(k) slice
+        if (!m_in_order) SortIndirectly();
+
+        const size_t first = std::min(offset, m_tasks.size());
+        const size_t last = first + std::min(limit, m_tasks.size() - first);
+
+        m_metrics.rows_scanned += last - first;
+        rows.reserve(last - first);
+        for (size_t i = first; i < last; i++) rows.push_back(&m_tasks[i]);
+    } else {
+        // A page of an out-of-date sort only needs the first `offset + limit` rows ordered
+        m_metrics.rows_scanned += m_tasks.size();
+        rows.reserve(m_tasks.size());
+        for (const auto &task : m_tasks) rows.push_back(&task);
+
+        PartialSortRows(rows, offset + std::min(limit, m_tasks.size()), m_prev_sort.first, m_prev_sort.second);
+        rows.erase(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(std::min(offset, rows.size())));
+    }
+
+    if (rows.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks on this page.\n";
+        return;
+    }
+
+    RenderTable(rows, m_tasks);
+}
+
+void Manager::ListPaged(const size_t offset, const size_t limit, const bool full)
+{
+    if (m_paged->size() == 0) {
+        m_out << "\n" << Icon("📭 ") << "No tasks available.\n";
+        return;
+    }
+
+    const size_t first = std::min(offset, m_paged->size());
+    const size_t last = first + std::min(limit, m_paged->size() - first);
+
+    if (first == last) {
+        m_out << "\n" << Icon("📭 ") << "No tasks on this page.\n";
+        return;
+    }
+
+    // The full listing has its layout maintained by the indexes, a page of it is measured in a first pass over its rows
+    TableLayout layout = m_widths.Layout();
+    bool read = true;
+
+    if (!full) {
+        ColumnArray content_widths{};
+        read = m_paged->Scan(first, last, [&](const TaskTable& page, const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const ColumnArray widths = ColumnWidths::Measure(page[i], page);
+                for (size_t column = 0; column < COLUMN_COUNT; column++) {
+                    content_widths[column] = std::max(content_widths[column], widths[column]);
+                }
+            }
+        });
+        layout = TableLayout::FromContentWidths(content_widths);
+    }
+
+    m_metrics.rows_scanned += last - first;
+
+    if (read) {
+        RenderHeader(layout);
+        read = m_paged->Scan(first, last, [&](const TaskTable& page, const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) RenderRow(page[i], page, layout);
+            m_metrics.rows_returned += end - begin;
+        });
+        RenderFooter(layout);
+    }
+
+    if (!read) Fail(m_err) << Icon("❌ ") << "Error: Unable to read the task store `" << STORE_FILE << "`, the listing is incomplete.\n";
+}
+
+void Manager::RenderTable(const std::vector<const Task*>& rows, const TaskTable& tasks)
+{
+    // A subset of the store is measured on the spot, it is at most one page in size
+    ColumnArray content_widths{};
+    for (const Task* row : rows) {
+        const ColumnArray widths = ColumnWidths::Measure(*row, tasks);
+        for (size_t column = 0; column < COLUMN_COUNT; column++) {
+            content_widths[column] = std::max(content_widths[column], widths[column]);
+        }
+    }
+
+    const TableLayout layout = TableLayout::FromContentWidths(content_widths);
+    m_metrics.rows_returned += rows.size();
+
+    RenderHeader(layout);
+    for (const Task* row : rows) RenderRow(*row, tasks, layout);
+    RenderFooter(layout);
+}
+
+void Manager::RenderHeader(const TableLayout& layout)
+{
+    OutputBuffer& out = m_output;
+    const ColumnArray& widths = layout.widths;
+
+    out.AppendRepeated('-', layout.total_width);
+    out.EndLine();
+
+    out.Append("| "); out.AppendPadded("ID", widths[static_cast<size_t>(Column::ID)]);
+    out.Append("| "); out.AppendPadded("Description", widths[static_cast<size_t>(Column::Description)]);
+    out.Append("| "); out.AppendPadded("Due Date", widths[static_cast<size_t>(Column::Due)]);
+    out.Append("| "); out.AppendPadded("Priority", widths[static_cast<size_t>(Column::Priority)]);
+    out.Append("| "); out.AppendPadded("Status", widths[static_cast<size_t>(Column::Status)]);
+    out.Append("| "); out.AppendPadded("Tags", widths[static_cast<size_t>(Column::Tags)]);
+    out.Append(" |");
+    out.EndLine();
+
+    out.AppendRepeated('-', layout.total_width);
+    out.EndLine();
+}
+
+void Manager::RenderRow(const Task& task, const TaskTable& tasks, const TableLayout& layout)
+{
+    OutputBuffer& out = m_output;
+    const ColumnArray& widths = layout.widths;
+
+    out.Append("| "); out.AppendNumber(task.id, widths[static_cast<size_t>(Column::ID)]);
+    out.Append("| "); out.AppendPadded(tasks.Description(task), widths[static_cast<size_t>(Column::Description)]);
+    out.Append("| "); out.AppendPadded(FormatDate(task.due), widths[static_cast<size_t>(Column::Due)]);
+    out.Append("| "); out.AppendPadded(GetPriorityStr(task.priority), widths[static_cast<size_t>(Column::Priority)]);
+    out.Append("| "); out.AppendPadded(status_names[static_cast<size_t>(task.status)], widths[static_cast<size_t>(Column::Status)]);
+    out.Append("| ");
+
+    size_t tag_length = 0;
+    for (bool first = true; const auto tag : tasks.Tags(task)) {
+        if (!first) {
+            out.Append(", ");  // Add separator before each new tag (except first)
+            tag_length += 2;
+        }
+        first = false;
+        out.Append(tag);
+        tag_length += tag.length();
+    }
+    out.AppendRepeated(' ', widths[static_cast<size_t>(Column::Tags)] - tag_length);
+
+    out.Append(" |");
+    out.EndLine();
+}
+
+void Manager::RenderFooter(const TableLayout& layout)
+{
+    OutputBuffer& out = m_output;
+
+    out.AppendRepeated('-', layout.total_width);
+    out.EndLine();
+    out.Flush();
+}
+
+void Manager::Edit()
+{
+    // Required flags
+    if (!FlagUsed(Flag::ID)) {
+        PrintArgumentError("--id", "is required for this command.");
+        return;
+    }
+
+    if (m_flags[Flag::ID].size() > 1) {
+        PrintArgumentError("--id", "only accepts **one** value for `edit`.");
+        return;
+    }
+
+    // No changes specified
+    if (m_flags.size() == 1) {
+        Fail(m_out) << Icon("❌ ") << "Error: No changes specified. Use other flags (e.g., --description, --priority, --due, --tags, --status) along with --id.\n";
+        return;
+    }
+
+
+    try {
+        if (!m_flags[Flag::ID][0].empty() && m_flags[Flag::ID][0][0] == '-') {
+            PrintInvalidValuesError("id", m_flags[Flag::ID][0], "must be a positive integer.");
+            return;
+        }
+
+        const unsigned int id = std::stoi(std::string(m_flags[Flag::ID][0]));
+        const auto it = FindTask(id);
+
+        if (it == m_tasks.end()) {
+            return PrintTaskNotFoundError(m_flags[Flag::ID][0]);
+        }
+
+        // The task is taken out of the indexes while it changes, even a failed edit may leave it modified
+        UnindexTask(*it);
+
+        bool updated = true;
+        for (const auto& [flag, values] : m_flags) {
+            if (!EditFlagUpdate(flag, values, it)) {
+                updated = false;
+                break;
+            }
+        }
+
+        IndexTask(*it);
+        if (!updated) return;
+
+        m_in_order = false;
+        m_out << Icon("✏️  ") << "Task (ID: " << it->id << ") updated successfully!\n";
+
+        AddToHistory();
+    } catch (const std::exception&) {
+        PrintInvalidValuesError("id", m_flags[Flag::ID][0], "integer");
+    }
+}
+
+void Manager::Delete()
+{
+    TaskQuery query;
+    if (!ParseSelection(query)) return;
+
+    // Wrong flags
+    if (m_flags.size() > static_cast<size_t>(FlagUsed(Flag::ID) + FlagUsed(Flag::Where))) {
+        PrintInvalidFlagsError(Command::Delete);
+        return;
+    }
+
+    std::vector<size_t> positions;
+    if (!SelectTasks(query, positions)) return;
+
+    const unsigned int first_id = m_tasks[positions.front()].id;
+    for (const size_t position : positions) {
+        UnindexTask(m_tasks[position]);
+        m_id_index.erase(m_tasks[position].id);
+    }
+
+    // Survivors keep their order, only the positions from the first gap onwards are re-indexed
+    m_tasks.Erase(positions);
+    ReindexFrom(positions.front());
+
+    if (positions.size() == 1)
+        m_out << Icon("🗑️  ") << "Task (ID: " << first_id << ") deleted successfully!\n";
+    else
+        m_out << Icon("🗑️  ") << positions.size() << " tasks deleted successfully!\n";
+
+    AddToHistory();
+}
+
+void Manager::Complete()
+{
+    TaskQuery query;
+    if (!ParseSelection(query)) return;
+
+    // Wrong flags
+    if (m_flags.size() > static_cast<size_t>(FlagUsed(Flag::ID) + FlagUsed(Flag::Where))) {
+        PrintInvalidFlagsError(Command::Complete);
+        return;
+    }
+
+    std::vector<size_t> positions;
+    if (!SelectTasks(query, positions)) return;
+
+    size_t changed = 0;
+    for (const size_t position : positions) {
+        Task& task = m_tasks[position];
+        if (task.status == Status::Completed) continue;
+
+        UnindexTask(task);
+        task.status = Status::Completed;
+        IndexTask(task);
+        changed++;
+    }
+
+    if (positions.size() == 1) {
+        const unsigned int id = m_tasks[positions.front()].id;
+
+        if (changed == 0)
+            m_out << Icon("⚠️ ") << "Task (ID: " << id << ") is already completed.\n";
+        else
+            m_out << Icon("✅ ") << "Task (ID: " << id << ") marked as completed!\n";
+    } else if (changed == 0) {
+        m_out << Icon("⚠️ ") << "Every selected task is already completed.\n";
+    } else {
+        m_out << Icon("✅ ") << changed << " tasks marked as completed!\n";
+    }
+
+    if (changed > 0) AddToHistory();
+}
+
+void Manager::Search()
+{
+    const bool description_present = FlagUsed(Flag::Description);
+    const bool tags_present = FlagUsed(Flag::Tags);
+    const bool archived_present = FlagUsed(Flag::IncludeArchived);
+
+    if (!description_present && !tags_present) {
+        return PrintArgumentError("--description / --tags", "should be present.");
+    }
+
+    if (m_flags.size() > static_cast<size_t>(description_present + tags_present + archived_present)) {
+        return PrintInvalidFlagsError(Command::Search);
+    }
+
+    if (!m_in_order) SortIndirectly();
+
+    std::vector<std::string> keywords;
+    if (description_present) SplitQuotedText(m_flags[Flag::Description][0], keywords);
+
+    // Calls `on_match` for every task of `tasks` the search matches. Tags are compared by ID, and the IDs are per table
+    std::vector<std::uint32_t> required_tags;
+    std::string description;
+    const auto search = [&](const TaskTable& tasks, const auto& on_match) {
+        required_tags.clear();
+        for (const std::string_view tag : m_flags[Flag::Tags]) {
+            if (const std::uint32_t tag_id = tasks.FindTag(tag); tag_id != TaskTable::NO_TAG) required_tags.push_back(tag_id);
+        }
+
+        m_metrics.rows_scanned += tasks.size();
+
+        for (const auto &task : tasks) {
+            if (description_present) {
+                description = tasks.Description(task);
+                ToLower(description);
+
+                const bool has_any_occurrences = std::ranges::any_of(keywords,
+                    [&description](const std::string& keyword) {
+                        return description.find(keyword) != std::string::npos;
+                    });
+
+                if (has_any_occurrences) {
+                    on_match(task);
+                    continue;
+                }
+            }
+
+            if (tags_present) {
+                const auto tag_ids = tasks.TagIds(task);
+                const bool has_any_tag = std::ranges::find_first_of(tag_ids, required_tags) != tag_ids.end();
+
+                if (has_any_tag)
+                    on_match(task);
+            }
+        }
+    };
+
+    std::vector<const Task*> rows;
+
+    if (!archived_present && !m_paged) {
+        search(m_tasks, [&rows](const Task& task) { rows.push_back(&task); });
+        ListIndirectly(rows);
+        return;
+    }
+
+    // The matches are copied into one table, the paged store and the archive are streamed and never held whole
+    TaskTable matches;
+    if (!m_paged) {
+        search(m_tasks, [&](const Task& task) { matches.push_back(task, m_tasks); });
+    } else if (!m_paged->Scan(0, m_paged->size(), [&](const TaskTable& page, size_t, size_t) {
+                   search(page, [&](const Task& task) { matches.push_back(task, page); });
+               })) {
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to read the task store `" << STORE_FILE << "`, only the tasks before the failure were searched.\n";
+    }
+
+    // A task still in the store (a crash between archiving and saving the store) is shown as it is there
+    const bool scanned = StoreFile::ScanArchive(ARCHIVE_FILE, [&](const TaskTable& chunk) {
+        search(chunk, [&](const Task& task) {
+            if (!m_id_index.contains(task.id)) matches.push_back(task, chunk);
         });
+    });
+
+    if (!scanned) Fail(m_err) << Icon("❌ ") << "Error: The archive `" << ARCHIVE_FILE << "` is damaged, only the tasks before the damage were searched.\n";
+
+    rows.reserve(matches.size());
+    for (const auto &task : matches) rows.push_back(&task);
+
+    if (rows.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks available.\n";
+        return;
+    }
+
+    RenderTable(rows, matches);
+}
+
+void Manager::Filter()
+{
+    const bool status_present = FlagUsed(Flag::Status);
+    const bool priority_present = FlagUsed(Flag::Priority);
+    const bool due_present = FlagUsed(Flag::Due);
+    const bool to_present = FlagUsed(Flag::To);
+
+    if (m_flags.size() > (status_present + priority_present + due_present + to_present)) {
+        PrintInvalidFlagsError(Command::Filter);
+        return;
+    }
+
+    if ((due_present && ((to_present && m_flags.size() > 2) || (!to_present && m_flags.size() > 1)))
+        || (!due_present && m_flags.size() > 1)) {
+        PrintArgumentError("filter", "supports only one filter at a time.");
+        return;
+    }
+
+    if (!m_in_order) SortIndirectly();
+
+    Status filter_status = Status::None;
+    Priority filter_priority = Priority::Invalid;
+    std::uint32_t start = 0, end = 0;
+
+    if (status_present) {
+        filter_status = GetStatus(m_flags[Flag::Status][0]);
+        if (filter_status == Status::None) {
+            PrintInvalidValuesError("status", m_flags[Flag::Status][0], "`pending` or `completed`");
+            return;
+        }
     }
     else if (priority_present) {
-        const Priority filter_priority = GetPriority(m_flags[Flag::Priority][0]);
+        filter_priority = GetPriority(m_flags[Flag::Priority][0]);
         if (filter_priority == Priority::Invalid) {
             PrintInvalidValuesError("priority", m_flags[Flag::Priority][0], "`high`, `medium`, `low`, or `none`");
             return;
         }
-
-        std::ranges::for_each(m_tasks, [filter_priority](Task& task) {
-            task.hidden = (task.priority != filter_priority);
-        });
     } else {
         std::string start_date = "1900-01-01";
         std::string end_date = "9999-12-31";
@@ -824,12 +1431,48 @@ void Manager::Filter()
             return;
         }
 
-        std::ranges::for_each(m_tasks, [&start_date, &end_date](Task& task) {
-            task.hidden = (task.due < start_date || task.due > end_date);
-        });
+        start = PackDate(start_date);
+        end = PackDate(end_date);
+    }
+
+    const auto matches = [&](const Task& task) {
+        if (status_present) return task.status == filter_status;
+        if (priority_present) return task.priority == filter_priority;
+        return task.due >= start && task.due <= end;
+    };
+
+    std::vector<const Task*> rows;
+
+    if (!m_paged) {
+        m_metrics.rows_scanned += m_tasks.size();
+        for (const auto &task : m_tasks) {
+            if (matches(task)) rows.push_back(&task);
+        }
+
+        ListIndirectly(rows);
+        return;
+    }
+
+    // Like `search`, the pages are streamed and only the matches are copied into one table
+    TaskTable found;
+    if (!m_paged->Scan(0, m_paged->size(), [&](const TaskTable& page, size_t, size_t) {
+            m_metrics.rows_scanned += page.size();
+            for (const auto &task : page) {
+                if (matches(task)) found.push_back(task, page);
+            }
+        })) {
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to read the task store `" << STORE_FILE << "`, only the tasks before the failure were filtered.\n";
+    }
+
+    rows.reserve(found.size());
+    for (const auto &task : found) rows.push_back(&task);
+
+    if (rows.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks available.\n";
+        return;
     }
 
-    ListIndirectly();
+    RenderTable(rows, found);
 }
 
 void Manager::Sort(const bool called_directly)
@@ -843,7 +1486,7 @@ void Manager::Sort(const bool called_directly)
         }
 
         if ((!order_present && m_flags.size() > 1) || (order_present && m_flags.size() > 2)) {
-            PrintInvalidFlagsError("sort", {"by", "order"});
+            PrintInvalidFlagsError(Command::Sort);
             return;
         }
     }
@@ -860,38 +1503,21 @@ void Manager::Sort(const bool called_directly)
             return;
         }
 
-        switch (sort_by) {
-            case Flag::Priority:
-                std::ranges::stable_sort(m_tasks, [](const Task& a, const Task& b) {
-                    return static_cast<int>(a.priority) < static_cast<int>(b.priority);
-                });
-                break;
-            case Flag::Due:
-                std::ranges::stable_sort(m_tasks, [](const Task& a, const Task& b) {
-                    return a.due < b.due;
-                });
-                break;
-            case Flag::ID:
-                std::ranges::stable_sort(m_tasks, [](const Task& a, const Task& b) {
-                    return a.id < b.id;
-                });
-                break;
-            default:
-                std::ranges::stable_sort(m_tasks, [](const Task& a, const Task& b) {
-                    return static_cast<int>(a.status) < static_cast<int>(b.status);
-                });
-                break;
-        }
+        std::ranges::stable_sort(m_tasks, [&sort_by](const Task& a, const Task& b) {
+            return CompareTasks(a, b, sort_by);
+        });
 
         if (order == Order::Descending) {
             std::ranges::reverse(m_tasks);
         }
 
+        ReindexFrom(0);
+
         m_prev_sort = std::make_pair(sort_by, order);
 
         if (called_directly) {
             m_in_order = true;
-            std::cout << "🔹 Tasks sorted by `" << m_flags[Flag::SortBy][0] << "` in `" << (order == Order::Ascending ? "ascending" : "descending") << "` order.\n";
+            m_out << Icon("🔹 ") << "Tasks sorted by `" << m_flags[Flag::SortBy][0] << "` in `" << (order == Order::Ascending ? "ascending" : "descending") << "` order.\n";
 
             AddToHistory();
         }
@@ -900,6 +1526,132 @@ void Manager::Sort(const bool called_directly)
     }
 }
 
+void Manager::Next()
+{
+    if (m_flags.size() > FlagUsed(Flag::Top)) {
+        PrintInvalidFlagsError(Command::Next);
+        return;
+    }
+
+    size_t count = 1;
+    if (FlagUsed(Flag::Top) && !ParseCount(Flag::Top, count)) return;
+
+    // Served from the pending queue alone: only the rows shown are looked up in the store
+    if (m_pending.size() == 0) {
+        m_out << "\n" << Icon("🎉 ") << "Nothing left to do, every task is completed.\n";
+        return;
+    }
+
+    const std::vector<unsigned int> ids = m_pending.Top(count);
+    if (ids.empty()) {
+        m_out << "\n" << Icon("📭 ") << "No tasks on this page.\n";
+        return;
+    }
+
+    std::vector<const Task*> rows;
+    rows.reserve(ids.size());
+    m_metrics.rows_scanned += ids.size();
+
+    if (!m_paged) {
+        for (const unsigned int id : ids) rows.push_back(&*FindTask(id));
+        RenderTable(rows, m_tasks);
+        return;
+    }
+
+    // Only the pages of the rows shown are fetched, the rows are copied out before the pool can evict them
+    TaskTable next_tasks;
+    for (const unsigned int id : ids) {
+        const auto [page, index] = m_paged->Locate(m_id_index.at(id));
+        const PagedStore::Page data = m_paged->Fetch(page);
+        if (!data) {
+            Fail(m_err) << Icon("❌ ") << "Error: Unable to read the task store `" << STORE_FILE << "`!\n";
+            return;
+        }
+        next_tasks.push_back((*data)[index], *data);
+    }
+
+    for (const auto &task : next_tasks) rows.push_back(&task);
+    RenderTable(rows, next_tasks);
+}
+
+void Manager::Report()
+{
+    if (m_flags.size() > FlagUsed(Flag::Json)) {
+        PrintInvalidFlagsError(Command::Report);
+        return;
+    }
+
+    // Every figure comes from the counters and the tag postings, the tasks themselves are never read
+    const TaskCounters::Matrix& matrix = m_counters.StatusPriority();
+
+    std::vector<std::pair<std::string_view, size_t>> tags;
+    tags.reserve(m_tags.size());
+    for (const auto &[tag, postings] : m_tags) tags.emplace_back(tag, postings.size());
+    std::ranges::sort(tags, [](const auto& a, const auto& b) { return std::tie(b.second, a.first) < std::tie(a.second, b.first); });
+
+    std::vector<std::pair<std::uint32_t, TaskCounters::WeekCounts>> weeks(m_counters.DueWeeks().begin(), m_counters.DueWeeks().end());
+    std::ranges::sort(weeks, {}, &std::pair<std::uint32_t, TaskCounters::WeekCounts>::first);
+
+    const auto status_of = [](const size_t status) {
+        std::string name(status_names[status]);
+        ToLower(name);
+        return name;
+    };
+
+    if (FlagUsed(Flag::Json)) {
+        json by_status = json::object();
+        for (size_t status = 0; status < STATUS_COUNT; status++) {
+            json row = json::object();
+            for (size_t priority = 0; priority < PRIORITY_COUNT; priority++) row[std::string(priority_names[priority])] = matrix[status][priority];
+            by_status[status_of(status)] = std::move(row);
+        }
+
+        json by_tag = json::object();
+        for (const auto &[tag, count] : tags) by_tag[std::string(tag)] = count;
+
+        json by_week = json::object();
+        const auto week_json = [](const TaskCounters::WeekCounts& counts) {
+            return json{{"pending", counts[static_cast<size_t>(Status::Pending)]},
+                        {"completed", counts[static_cast<size_t>(Status::Completed)]}};
+        };
+        for (const auto &[week, counts] : weeks) by_week[FormatDate(week)] = week_json(counts);
+        by_week["none"] = week_json(m_counters.Undated());
+
+        m_out << json{{"report", {{"total", m_counters.Total()}, {"status_priority", by_status}, {"tags", by_tag},
+                                  {"due_weeks", by_week}}}}.dump(4) << "\n";
+        return;
+    }
+
+    m_out << "\n" << Icon("📈 ") << "Report of " << m_counters.Total() << " task(s)\n";
+
+    m_out << "\n" << Icon("🔢 ") << "Status x priority:\n  " << std::left << std::setw(11) << "status" << std::right;
+    for (size_t priority = PRIORITY_COUNT; priority-- > 0;) m_out << std::setw(10) << priority_names[priority];
+    m_out << std::setw(10) << "total" << "\n";
+    for (size_t status = 0; status < STATUS_COUNT; status++) {
+        size_t total = 0;
+        m_out << "  " << std::left << std::setw(11) << status_of(status) << std::right;
+        for (size_t priority = PRIORITY_COUNT; priority-- > 0;) {
+            m_out << std::setw(10) << matrix[status][priority];
+            total += matrix[status][priority];
+        }
+        m_out << std::setw(10) << total << "\n";
+    }
+
+    m_out << "\n" << Icon("🏷️  ") << "Tags (tasks carrying each):\n";
+    if (tags.empty()) m_out << "  (no tags)\n";
+    for (const auto &[tag, count] : tags) m_out << "  " << std::left << std::setw(24) << tag << std::right << std::setw(10) << count << "\n";
+
+    m_out << "\n" << Icon("📅 ") << "Due weeks (starting on Monday):\n  " << std::left << std::setw(14) << "week" << std::right
+          << std::setw(10) << "pending" << std::setw(11) << "completed" << "\n";
+    const auto week_row = [this](const std::string_view week, const TaskCounters::WeekCounts& counts) {
+        m_out << "  " << std::left << std::setw(14) << week << std::right
+              << std::setw(10) << counts[static_cast<size_t>(Status::Pending)]
+              << std::setw(11) << counts[static_cast<size_t>(Status::Completed)] << "\n";
+    };
+    for (const auto &[week, counts] : weeks) week_row(FormatDate(week), counts);
+    week_row("no due date", m_counters.Undated());
+}
+
 void Manager::Tag()
 {
     const bool id_used = FlagUsed(Flag::ID);
@@ -912,7 +1664,7 @@ void Manager::Tag()
 
     if (list_used) {
         if (m_flags.size() > 1) {
-            PrintInvalidFlagsError("tag --list", {"list"});
+            PrintInvalidFlagsError(Command::Tag);
             return;
         }
 
@@ -921,13 +1673,13 @@ void Manager::Tag()
         return;
     }
 
-    if (!id_used) {
-        PrintArgumentError("--id", "is required for tag manipulation.");
+    if (FlagUsed(Flag::Rename) || FlagUsed(Flag::Merge) || FlagUsed(Flag::Into)) {
+        RetagTasks();
         return;
     }
 
-    if (m_flags.size() != 2) {
-        PrintArgumentError("tag", "must include --id and either --add or --remove.");
+    if (m_flags.size() != static_cast<size_t>(id_used + FlagUsed(Flag::Where) + 1)) {
+        PrintArgumentError("tag", "must include --id and/or --where, and either --add or --remove.");
         return;
     }
 
@@ -939,49 +1691,157 @@ void Manager::Tag()
         return;
     }
 
-    if (!m_flags[Flag::ID][0].empty() && m_flags[Flag::ID][0][0] == '-') {
-        PrintInvalidValuesError("id", m_flags[Flag::ID][0], "must be a positive integer.");
+    const std::string_view tag = m_flags[add_used ? Flag::Add : Flag::Remove][0];
+    if (add_used && tag.find(TAG_DELIMITER) != std::string::npos) {
+        Fail(m_err) << Icon("❌ ") << "Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER << "\n";
+        return;
+    }
+    if (add_used && tag.size() > StoreFile::MAX_TAG_BYTES) {
+        Fail(m_err) << Icon("❌ ") << "Error: A tag can be at most " << StoreFile::MAX_TAG_BYTES << " bytes long!\n";
         return;
     }
 
-    const unsigned short int id = std::stoi(m_flags[Flag::ID][0]);
+    TaskQuery query;
+    if (!ParseSelection(query)) return;
 
-    if (const auto it = std::ranges::find_if(m_tasks,
-                [id](const Task& task) { return task.id == id; }); it != m_tasks.end()) {
-        const std::string tag = m_flags[add_used ? Flag::Add : Flag::Remove][0];
+    std::vector<size_t> positions;
+    if (!SelectTasks(query, positions)) return;
 
-        if (add_used) {
-            if (std::ranges::find(it->tags, tag) == it->tags.end()) {
-                if (tag.find(TAG_DELIMITER) != std::string::npos) {
-                    std::cerr << "❌ Error: Tag '" << tag << "' contains the forbidden delimiter '" << TAG_DELIMITER << "\n";
-                    return;
-                }
-                it->tags.push_back(tag);
-                m_tags.try_emplace(tag, 0).first->second++;
-                std::cout << "✅ Tag `" << tag << "` added to Task ID: " << id << "\n";
+    const std::uint32_t tag_id = add_used ? m_tasks.InternTag(tag) : m_tasks.FindTag(tag);
+    std::vector<std::uint32_t> tag_ids;
+
+    size_t changed = 0;
+    for (const size_t position : positions) {
+        Task& task = m_tasks[position];
+        const auto current = m_tasks.TagIds(task);
+        if ((std::ranges::find(current, tag_id) != current.end()) == add_used) continue;
+
+        UnindexTask(task);
+        tag_ids.assign(current.begin(), current.end());
+        if (add_used) tag_ids.push_back(tag_id);
+        else std::erase(tag_ids, tag_id);
+        m_tasks.SetTags(task, tag_ids);
+        IndexTask(task);
+        changed++;
+    }
+
+    if (positions.size() == 1) {
+        const unsigned int id = m_tasks[positions.front()].id;
+
+        if (changed == 0)
+            m_out << Icon("⚠️ ") << "Task ID " << id << (add_used ? " already has" : " does not have") << " tag `" << tag << "`.\n";
+        else if (add_used)
+            m_out << Icon("✅ ") << "Tag `" << tag << "` added to Task ID: " << id << "\n";
+        else
+            m_out << Icon("🗑️  ") << "Tag `" << tag << "` removed from Task ID: " << id << "\n";
+    } else if (changed == 0) {
+        m_out << Icon("⚠️ ") << (add_used ? "Every selected task already has" : "None of the selected tasks has") << " tag `" << tag << "`.\n";
+    } else if (add_used) {
+        m_out << Icon("✅ ") << "Tag `" << tag << "` added to " << changed << " tasks\n";
+    } else {
+        m_out << Icon("🗑️  ") << "Tag `" << tag << "` removed from " << changed << " tasks\n";
+    }
+
+    if (changed > 0) AddToHistory();
+}
+
+void Manager::RetagTasks()
+{
+    const bool rename_used = FlagUsed(Flag::Rename);
+
+    if (rename_used && m_flags.size() != 1) {
+        PrintArgumentError("--rename", "cannot be combined with other flags.");
+        return;
+    }
+
+    if (!rename_used && (!FlagUsed(Flag::Merge) || !FlagUsed(Flag::Into) || m_flags.size() != 2)) {
+        PrintArgumentError("tag", "must use `--rename OLD NEW` or `--merge tag1 tag2 ... --into TAG` on their own.");
+        return;
+    }
+
+    if (rename_used && m_flags[Flag::Rename].size() != 2) {
+        PrintArgumentError("--rename", "takes exactly two values: the old and the new tag name.");
+        return;
+    }
+
+    const FlagValues& values = m_flags[rename_used ? Flag::Rename : Flag::Merge];
+    const std::pmr::string target(rename_used ? values[1] : m_flags[Flag::Into][0]);
+
+    if (target.find(TAG_DELIMITER) != std::string::npos) {
+        Fail(m_err) << Icon("❌ ") << "Error: Tag '" << target << "' contains the forbidden delimiter '" << TAG_DELIMITER << "\n";
+        return;
+    }
+    if (target.size() > StoreFile::MAX_TAG_BYTES) {
+        Fail(m_err) << Icon("❌ ") << "Error: A tag can be at most " << StoreFile::MAX_TAG_BYTES << " bytes long!\n";
+        return;
+    }
+
+    // Only the source tags' postings are visited, the target tag is never a source of itself
+    std::vector<std::pmr::string> sources;
+    for (const std::string_view source : rename_used ? std::span(values.begin(), 1) : std::span(values.begin(), values.end())) {
+        if (source != target && std::ranges::find(sources, source) == sources.end()) sources.emplace_back(source);
+    }
+
+    if (sources.empty()) {
+        if (rename_used) m_out << Icon("⚠️ ") << "Nothing to rename, tag `" << values[0] << "` already has that name.\n";
+        else m_out << Icon("⚠️ ") << "Nothing to merge, every tag given is `" << target << "` already.\n";
+        return;
+    }
+
+    std::vector<unsigned int> affected;
+    for (const auto &source : sources) {
+        if (const auto it = m_tags.find(source); it != m_tags.end())
+            affected.insert(affected.end(), it->second.begin(), it->second.end());
+    }
+    std::ranges::sort(affected);
+    affected.erase(std::ranges::unique(affected).begin(), affected.end());
+
+    if (affected.empty()) {
+        m_out << Icon("⚠️ ") << "No task carries " << (rename_used ? "tag `" + std::string(values[0]) + "`" : "any of the tags to merge") << ".\n";
+        return;
+    }
+
+    // Each task gets the target tag once, in place of its first source tag; the postings move in bulk afterwards
+    const std::uint32_t target_id = m_tasks.InternTag(target);
+    std::vector<std::uint32_t> source_ids;
+    for (const auto &source : sources) {
+        if (const std::uint32_t tag_id = m_tasks.FindTag(source); tag_id != TaskTable::NO_TAG) source_ids.push_back(tag_id);
+    }
+
+    std::vector<std::uint32_t> tag_ids;
+    for (const unsigned int id : affected) {
+        Task& task = *FindTask(id);
+        m_widths.Remove(task, m_tasks);
+
+        const auto current = m_tasks.TagIds(task);
+        tag_ids.assign(current.begin(), current.end());
+
+        const bool had_target = std::ranges::find(tag_ids, target_id) != tag_ids.end();
+        const auto first_source = std::ranges::find_first_of(tag_ids, source_ids);
+        if (!had_target) *first_source = target_id;
+
+        std::erase_if(tag_ids, [&source_ids](const std::uint32_t tag_id) {
+            return std::ranges::find(source_ids, tag_id) != source_ids.end();
+        });
+        m_tasks.SetTags(task, tag_ids);
 
-                AddToHistory();
-            } else {
-                std::cout << "⚠️ Task ID " << id << " already has tag `" << tag << "`.\n";
-            }
-        } else {
-            const auto tag_it = std::ranges::find(it->tags, tag);
-            if (tag_it != it->tags.end()) {
-                if (--m_tags[tag] == 0) {
-                    m_tags.erase(tag);
-                }
-                it->tags.erase(tag_it);
-                it->tags.shrink_to_fit();
-                std::cout << "🗑️  Tag `" << tag << "` removed from Task ID: " << id << "\n";
+        m_widths.Add(task, m_tasks);
+    }
 
-                AddToHistory();
-            } else {
-                std::cout << "⚠️ Task ID " << id << " does not have tag `" << tag << "`.\n";
-            }
+    auto& target_postings = m_tags[target];
+    for (const auto &source : sources) {
+        if (const auto it = m_tags.find(source); it != m_tags.end()) {
+            target_postings.merge(it->second);
+            m_tags.erase(it);
         }
-    } else {
-        PrintTaskNotFoundError(m_flags[Flag::ID][0]);
     }
+
+    if (rename_used)
+        m_out << Icon("🏷️  ") << "Tag `" << values[0] << "` renamed to `" << target << "` on " << affected.size() << " task(s)\n";
+    else
+        m_out << Icon("🏷️  ") << sources.size() << " tag(s) merged into `" << target << "` on " << affected.size() << " task(s)\n";
+
+    AddToHistory();
 }
 
 void Manager::Undo()
@@ -991,14 +1851,26 @@ void Manager::Undo()
         return;
     }
 
+    // Inside a batch the uncommitted changes form the last action
+    if (m_batch_changed) {
+        m_out << Icon("🔄 ") << "Last action undone successfully!\n";
+        m_batch_changed = false;
+        m_store_changed = true;
+        m_tasks = *history.back();
+        RebuildIndexes();
+        return;
+    }
+
     if (history.size() == 1) {
-        std::cout << "❌ Error: No actions to undo!\n";
+        Fail(m_out) << Icon("❌ ") << "Error: No actions to undo!\n";
         return;
     }
 
-    std::cout << "🔄 Last action undone successfully!\n";
+    m_out << Icon("🔄 ") << "Last action undone successfully!\n";
     history.pop_back();
-    m_tasks = history.back();
+    m_tasks = *history.back();
+    m_store_changed = true;
+    RebuildIndexes();
 }
 
 void Manager::Export()
@@ -1009,13 +1881,23 @@ void Manager::Export()
     }
 
     if (m_flags.size() > 1) {
-        PrintInvalidFlagsError("export", {"file"});
+        PrintInvalidFlagsError(Command::Export);
         return;
     }
 
-    std::string file_path = m_flags[Flag::File][0];
+    if (m_flags[Flag::File].size() > 1) {
+        PrintArgumentError("--file", "only accepts **one** value for `export`.");
+        return;
+    }
+
+    std::string file_path(m_flags[Flag::File][0]);
+
+    // `.gz` is stripped first so that `tasks.csv.gz` is validated like `tasks.csv`
+    std::filesystem::path format_path(file_path);
+    const bool compressed = format_path.extension() == ".gz";
+    if (compressed) format_path.replace_extension();
 
-    std::string filename = std::filesystem::path(file_path).stem().string();
+    std::string filename = format_path.stem().string();
 
     if (filename.find_first_of(R"(/:*?"<>|)") != std::string::npos) {
         PrintInvalidValuesError("file", filename, "Cannot contain invalid characters.");
@@ -1027,101 +1909,126 @@ void Manager::Export()
         return;
     }
 
-    std::string file_format = std::filesystem::path(file_path).extension().string();
+    std::string file_format = format_path.extension().string();
 
     if (file_format == ".csv") file_format = "csv";
     else if (file_format == ".json") file_format = "json";
     else if (file_format == ".txt") file_format = "txt";
     else {
-        PrintInvalidValuesError("file", file_format, "csv/txt/json");
+        PrintInvalidValuesError("file", file_format, "csv/txt/json (optionally followed by .gz)");
         return;
     }
 
-    std::ofstream file(file_path, std::ios::out);
+    std::unique_ptr<std::ostream> file_stream;
+    if (compressed) file_stream = std::make_unique<GzipOfstream>(file_path);
+    else file_stream = std::make_unique<std::ofstream>(file_path, std::ios::out);
+
+    std::ostream& file = *file_stream;
     if (!file) {
-        std::cerr << "❌ Error: Unable to open file for writing!" << std::endl;
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to open file for writing!" << std::endl;
         return;
     }
 
-    if (file_format == "csv" || file_format == "txt") {
-        for (const auto& task : m_tasks) {
+    // Records are written one at a time, so the tasks can come from the paged store as well as from `m_tasks`
+    const bool as_json = file_format == "json";
+    size_t exported = 0;
+
+    const auto write_task = [&](const TaskTable& tasks, const Task& task) {
+        if (!as_json) {
             file << task.id << ",";
-            file << "\"" << task.description << "\"" << ",";
-            file << task.due << ",";
+            file << "\"" << tasks.Description(task) << "\"" << ",";
+            file << FormatDate(task.due) << ",";
             file << GetPriorityStr(task.priority) << ",";
             file << (task.status == Status::Pending ? "Pending," : "Completed,");
             file << "\"";
-            for (size_t i = 0; i < task.tags.size(); i++) {
-                file << task.tags[i];
-                if (i < task.tags.size() - 1) file << TAG_DELIMITER;
+            for (bool first = true; const auto tag : tasks.Tags(task)) {
+                if (!first) file << TAG_DELIMITER;
+                first = false;
+                file << tag;
             }
             file << "\"";
-            file << std::endl;
+            file << "\n";
+            exported++;
+            return;
         }
-    } else {
-        json json_array = json::array();
-
-        for (const auto& task : m_tasks) {
-            json task_json = {
-                {"id", task.id},
-                {"description", task.description},
-                {"due", task.due},
-                {"priority", task.priority},
-                {"status", task.status},
-                {"tags", task.tags}  // JSON automatically converts vector<string> to array
-            };
 
-            json_array.push_back(task_json);
-        }
+        json tags = json::array();
+        for (const auto tag : tasks.Tags(task)) tags.emplace_back(tag);
 
-        file << json_array.dump(4);
-    }
+        const json task_json = {
+            {"id", task.id},
+            {"description", tasks.Description(task)},
+            {"due", FormatDate(task.due)},
+            {"priority", task.priority},
+            {"status", task.status},
+            {"tags", std::move(tags)}
+        };
 
-    file.close();
+        // Laid out exactly as the element of an array dumped whole would be
+        std::string element = task_json.dump(4);
+        for (size_t at = element.find('\n'); at != std::string::npos; at = element.find('\n', at + 1)) element.insert(at + 1, 4, ' ');
 
-    std::cout << "✅ Data successfully written to " << file_path << "!" << std::endl;
-}
+        file << (exported == 0 ? "[\n    " : ",\n    ") << element;
+        exported++;
+    };
 
-void Manager::Import()
-{
-    if (!FlagUsed(Flag::File)) {
-        PrintArgumentError("--file", "is required for this command.");
-        return;
+    bool read = true;
+    if (!m_paged) {
+        for (const auto& task : m_tasks) write_task(m_tasks, task);
+    } else {
+        read = m_paged->Scan(0, m_paged->size(), [&](const TaskTable& page, const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) write_task(page, page[i]);
+        });
     }
 
-    if (m_flags.size() > 1) {
-        PrintInvalidFlagsError("import", {"file"});
-        return;
-    }
+    if (as_json) file << (exported == 0 ? "[]" : "\n]");
 
-    std::string file_path = m_flags[Flag::File][0];
+    if (compressed) static_cast<GzipOfstream&>(file).close();
+    else static_cast<std::ofstream&>(file).close();
 
-    if (!std::filesystem::exists(file_path)) {
-        std::cerr << "❌ Error: File does not exist!" << std::endl;
+    if (!file) {
+        Fail(m_err) << Icon("❌ ") << "Error: Failed while writing to " << file_path << "!" << std::endl;
         return;
     }
 
-    std::string file_format = std::filesystem::path(file_path).extension().string();
+    m_metrics.rows_scanned += exported;
+    m_metrics.rows_returned += exported;
 
-    if (file_format == ".csv") file_format = "csv";
-    else if (file_format == ".json") file_format = "json";
-    else if (file_format == ".txt") file_format = "txt";
-    else {
-        PrintInvalidValuesError("file", file_format, "csv/txt/json");
+    if (!read) {
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to read the task store `" << STORE_FILE << "`, " << file_path << " holds only the tasks before the failure!\n";
         return;
     }
 
-    std::ifstream file(file_path);
+    std::error_code ec;
+    if (const auto size = std::filesystem::file_size(file_path, ec); !ec) m_metrics.bytes_written += size;
+
+    m_out << Icon("✅ ") << "Data successfully written to " << file_path << "!" << std::endl;
+}
+
+void Manager::ParseImportFile(ImportBatch& batch)
+{
+    std::filesystem::path format_path(batch.file_path);
+    const bool compressed = format_path.extension() == ".gz";
+    if (compressed) format_path.replace_extension();
+
+    const std::string file_format = format_path.extension().string();
+
+    std::unique_ptr<std::istream> file_stream;
+    if (compressed) file_stream = std::make_unique<GzipIfstream>(batch.file_path);
+    else file_stream = std::make_unique<std::ifstream>(batch.file_path);
+
+    std::istream& file = *file_stream;
     if (!file) {
-        std::cerr << "❌ Error: Unable to open file for reading!" << std::endl;
+        batch.warnings.emplace_back("❌ Error: Unable to open file for reading!");
+        batch.failed = true;
         return;
     }
 
-    std::vector<Task> imported_tasks;
-    std::unordered_set<unsigned short> existing_ids;
-    for (const auto& task : m_tasks) existing_ids.insert(task.id);
+    // Only IDs repeated within the file are dropped here, conflicts with the store are resolved by the merge
+    TaskTable& imported_tasks = batch.tasks;
+    std::unordered_set<unsigned int> seen_ids;
 
-    if (file_format == "csv" || file_format == "txt") {
+    if (file_format == ".csv" || file_format == ".txt") {
         std::string line;
         while (std::getline(file, line)) {
             std::istringstream ss(line);
@@ -1130,29 +2037,32 @@ void Manager::Import()
 
             if (!std::getline(ss, field, ',')) continue;
             try {
-                task.id = static_cast<unsigned short>(std::stoi(field));
-                if (existing_ids.contains(task.id)) continue;
+                task.id = static_cast<unsigned int>(std::stoi(field));
+                if (seen_ids.contains(task.id)) { batch.skipped++; continue; }
             } catch (...) {
-                std::cerr << "⚠️ Skipping invalid task ID: " << field << "\n";
+                batch.warnings.push_back("⚠️ Skipping invalid task ID: " + field);
+                batch.skipped++;
                 continue;
             }
 
             if (!std::getline(ss, field, '"')) continue;
             if (!std::getline(ss, field, '"')) continue;
-            task.description = field;
+            imported_tasks.SetDescription(task, field);
 
             if (!std::getline(ss, field, ',')) continue;
             if (!std::getline(ss, field, ',')) continue;
             if (ValidateDateFormat(field) != DateValidationResult::Success && !field.empty()) {
-                std::cerr << "⚠️ Skipping task with invalid due date: " << field << "\n";
+                batch.warnings.push_back("⚠️ Skipping task with invalid due date: " + field);
+                batch.skipped++;
                 continue;
             }
-            task.due = field;
+            task.due = PackDate(field);
 
             if (!std::getline(ss, field, ',')) continue;
             task.priority = GetPriority(field);
             if (task.priority == Priority::Invalid) {
-                std::cerr << "⚠️ Skipping task with invalid priority: " << field << "\n";
+                batch.warnings.push_back("⚠️ Skipping task with invalid priority: " + field);
+                batch.skipped++;
                 continue;
             }
 
@@ -1162,7 +2072,8 @@ void Manager::Import()
             } else if (field == "Completed") {
                 task.status = Status::Completed;
             } else {
-                std::cerr << "⚠️ Skipping task with invalid status: " << field << "\n";
+                batch.warnings.push_back("⚠️ Skipping task with invalid status: " + field);
+                batch.skipped++;
                 continue;
             }
 
@@ -1176,73 +2087,310 @@ void Manager::Import()
                 unique_values.insert(tag);
             }
 
-            task.tags.assign(unique_values.begin(), unique_values.end());
+            if (std::ranges::any_of(unique_values, [](const std::string& value) { return value.size() > StoreFile::MAX_TAG_BYTES; })) {
+                batch.warnings.push_back("⚠️ Skipping task with a tag longer than " + std::to_string(StoreFile::MAX_TAG_BYTES) + " bytes.");
+                batch.skipped++;
+                continue;
+            }
+
+            imported_tasks.SetTags(task, unique_values);
+            seen_ids.insert(task.id);
             imported_tasks.push_back(task);
-            existing_ids.insert(task.id);
         }
     }
     else {
         json json_array;
-        file >> json_array;
+
+        try {
+            file >> json_array;
+            imported_tasks.reserve(json_array.size());
+        } catch (const json::exception&) {
+            batch.warnings.emplace_back("❌ Error: File is not valid JSON!");
+            batch.failed = true;
+            return;
+        }
 
         for (const auto& task_json : json_array) {
             Task task;
             try {
                 task.id = task_json["id"];
-                if (existing_ids.contains(task.id)) continue;
+                if (seen_ids.contains(task.id)) { batch.skipped++; continue; }
             } catch (...) {
-                std::cerr << "⚠️ Skipping invalid task ID in JSON.\n";
+                batch.warnings.emplace_back("⚠️ Skipping invalid task ID in JSON.");
+                batch.skipped++;
                 continue;
             }
 
-            task.description = task_json["description"];
-            task.due = task_json["due"];
+            imported_tasks.SetDescription(task, task_json["description"].get_ref<const std::string&>());
+            std::string due = task_json["due"];
 
-            if (!task.due.empty() && ValidateDateFormat(task.due) != DateValidationResult::Success) {
-                std::cerr << "⚠️ Skipping task with invalid due date in JSON.\n";
+            if (!due.empty() && ValidateDateFormat(due) != DateValidationResult::Success) {
+                batch.warnings.emplace_back("⚠️ Skipping task with invalid due date in JSON.");
+                batch.skipped++;
                 continue;
             }
+            task.due = PackDate(due);
 
             try {
                 task.priority = static_cast<Priority>(task_json["priority"]);
             } catch (...) {
-                std::cerr << "⚠️ Skipping task with invalid priority in JSON.\n";
+                batch.warnings.emplace_back("⚠️ Skipping task with invalid priority in JSON.");
             }
 
             if (task.priority == Priority::Invalid) {
-                std::cerr << "⚠️ Skipping task with invalid priority in JSON.\n";
+                batch.warnings.emplace_back("⚠️ Skipping task with invalid priority in JSON.");
+                batch.skipped++;
                 continue;
             }
 
             try {
                 task.status = static_cast<Status>(task_json["status"]);
             } catch (...) {
-                std::cerr << "⚠️ Skipping task with invalid status in JSON.\n";
+                batch.warnings.emplace_back("⚠️ Skipping task with invalid status in JSON.");
             }
 
             if (task.status == Status::None) {
-                std::cerr << "⚠️ Skipping task with invalid status in JSON.\n";
+                batch.warnings.emplace_back("⚠️ Skipping task with invalid status in JSON.");
+                batch.skipped++;
                 continue;
             }
 
-            task.tags = task_json["tags"].get<std::vector<std::string>>();
+            const auto tags = task_json["tags"].get<std::vector<std::string>>();
+            if (std::ranges::any_of(tags, [](const std::string& value) { return value.size() > StoreFile::MAX_TAG_BYTES; })) {
+                batch.warnings.push_back("⚠️ Skipping task with a tag longer than " + std::to_string(StoreFile::MAX_TAG_BYTES) + " bytes in JSON.");
+                batch.skipped++;
+                continue;
+            }
+            imported_tasks.SetTags(task, tags);
 
+            seen_ids.insert(task.id);
             imported_tasks.push_back(task);
-            existing_ids.insert(task.id);
         }
     }
 
-    file.close();
+    // A damaged `.gz` reads like a shorter file, what was read of it is not imported
+    if (compressed) {
+        if (auto &gzip = static_cast<GzipIfstream&>(file); !gzip.CheckEnd()) {
+            batch.warnings.push_back("❌ Error: File is damaged (" + gzip.Error() + ")!");
+            batch.failed = true;
+        }
+    }
+}
+
+void Manager::Import()
+{
+    if (!FlagUsed(Flag::File)) {
+        PrintArgumentError("--file", "is required for this command.");
+        return;
+    }
+
+    const bool mode_used = FlagUsed(Flag::Mode);
+
+    if (m_flags.size() > static_cast<size_t>(1 + mode_used)) {
+        PrintInvalidFlagsError(Command::Import);
+        return;
+    }
+
+    const ImportMode mode = mode_used ? GetImportMode(m_flags[Flag::Mode][0]) : ImportMode::Skip;
+    if (mode == ImportMode::None) {
+        PrintInvalidValuesError("mode", m_flags[Flag::Mode][0], "`upsert`, `skip`, `replace`");
+        return;
+    }
+
+    // Every file is checked up front so that a typo doesn't leave a half-applied import behind
+    const FlagValues& file_paths = m_flags[Flag::File];
+
+    for (const auto &file_path : file_paths) {
+        if (!std::filesystem::exists(file_path)) {
+            Fail(m_err) << Icon("❌ ") << "Error: File `" << file_path << "` does not exist!" << std::endl;
+            return;
+        }
+
+        std::filesystem::path format_path(file_path);
+        if (format_path.extension() == ".gz") format_path.replace_extension();
+
+        if (const std::string file_format = format_path.extension().string();
+            file_format != ".csv" && file_format != ".json" && file_format != ".txt") {
+            PrintInvalidValuesError("file", file_format, "csv/txt/json (optionally followed by .gz)");
+            return;
+        }
+    }
+
+    for (const auto &file_path : file_paths) {
+        std::error_code ec;
+        if (const auto size = std::filesystem::file_size(file_path, ec); !ec) m_metrics.bytes_read += size;
+    }
+
+    // Parse every file into its own staging batch, files are claimed by the workers one at a time
+    std::vector<ImportBatch> batches(file_paths.size());
+    for (size_t i = 0; i < file_paths.size(); i++) batches[i].file_path = file_paths[i];
+
+    {
+        const size_t worker_count = std::min<size_t>(batches.size(), std::max(1u, std::thread::hardware_concurrency()));
+        std::atomic<size_t> next_batch{0};
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count);
+
+        for (size_t i = 0; i < worker_count; i++) {
+            workers.emplace_back([&batches, &next_batch] {
+                for (size_t b = next_batch++; b < batches.size(); b = next_batch++) {
+                    ParseImportFile(batches[b]);
+                }
+            });
+        }
+    }
+
+    // Single conflict resolution pass over the staged batches, in command line order
+    ImportSummary total;
+    bool first_batch = true;
+
+    for (auto &batch : batches) {
+        for (const auto &warning : batch.warnings) m_err << Plain(warning) << "\n";
+        if (batch.failed) {
+            m_failed = true;
+            continue;
+        }
+
+        const ImportSummary summary = MergeImportedTasks(batch.tasks,
+            (mode == ImportMode::Replace && !first_batch) ? ImportMode::Skip : mode);
+        first_batch = false;
+
+        batch.summary = summary;
+        total.added += summary.added;
+        total.updated += summary.updated;
+        total.unchanged += summary.unchanged;
+        total.skipped += summary.skipped + batch.skipped;
+    }
+
+    // The whole import is recorded as a single undo unit. Like `add`, it leaves the active sort to the next read
+    if (total.added > 0 || total.updated > 0 || (mode == ImportMode::Replace && !first_batch)) {
+        m_in_order = false;
+        AddToHistory();
+    }
+
+    // A single file that failed has been reported above, there is nothing to sum up
+    if (batches.size() == 1 && batches[0].failed) return;
+
+    if (batches.size() == 1) {
+        m_out << Icon("✅ ") << "Successfully imported " << total.added << " tasks from " << batches[0].file_path << "!";
+    } else {
+        m_out << Icon("✅ ") << "Successfully imported " << total.added << " tasks from " << batches.size() << " files!";
+    }
+
+    if (mode == ImportMode::Upsert) {
+        m_out << " (" << total.updated << " updated, " << total.unchanged << " unchanged)";
+    } else if (total.skipped > 0) {
+        m_out << " (" << total.skipped << " skipped)";
+    }
+    m_out << "\n";
+
+    if (batches.size() > 1) {
+        for (const auto &batch : batches) {
+            m_out << "   " << Icon("📄 ") << batch.file_path << ": ";
+            if (batch.failed) {
+                m_out << "failed\n";
+                continue;
+            }
+
+            m_out << batch.summary.added << " imported, ";
+            if (mode == ImportMode::Upsert) m_out << batch.summary.updated << " updated, ";
+            m_out << batch.summary.skipped + batch.skipped << " skipped\n";
+        }
+    }
+}
+
+void Manager::Archive()
+{
+    if (m_flags.size() > FlagUsed(Flag::Before)) {
+        PrintInvalidFlagsError(Command::Archive);
+        return;
+    }
+
+    std::uint32_t before = 0;
+    if (FlagUsed(Flag::Before)) {
+        std::string date(m_flags[Flag::Before][0]);
+        if (const auto result = ValidateDateFormat(date); result != DateValidationResult::Success) {
+            return PrintInvalidValuesError("before", date,
+                result == DateValidationResult::InvalidFormat ? "Format: `YYYY-MM-DD`, `YYYY.MM.DD`, `YYYY/MM/DD`" : "Real day in a calendar starting from (1900-01-01)");
+        }
+        before = PackDate(date);
+    }
+
+    size_t archived = 0;
+    if (!ArchiveTasks(before, archived)) return;
+
+    if (archived == 0)
+        m_out << Icon("📭 ") << "No completed tasks to archive.\n";
+    else
+        m_out << Icon("🗄️  ") << archived << " completed task(s) moved to `" << ARCHIVE_FILE << "`.\n";
+}
+
+bool Manager::ArchiveTasks(const std::uint32_t before, size_t& archived)
+{
+    if (m_store_damaged) {
+        Fail(m_err) << Icon("❌ ") << "Error: The task store `" << STORE_FILE << "` is damaged, no task is archived.\n";
+        return false;
+    }
+
+    std::vector<size_t> positions;
+    m_metrics.rows_scanned += m_tasks.size();
+    for (size_t i = 0; i < m_tasks.size(); i++) {
+        const Task& task = m_tasks[i];
+        if (task.status == Status::Completed && (before == 0 || (task.due != 0 && task.due < before))) positions.push_back(i);
+    }
+
+    archived = positions.size();
+    if (positions.empty()) return true;
 
-    m_tasks.insert(m_tasks.end(), imported_tasks.begin(), imported_tasks.end());
+    // Durable in the archive first: a crash before the store is saved leaves a task in both, never in neither
+    if (!StoreFile::AppendArchive(ARCHIVE_FILE, m_tasks, positions)) {
+        Fail(m_err) << Icon("❌ ") << "Error: Unable to append to the archive `" << ARCHIVE_FILE << "` (unwritable or damaged), no task is archived.\n";
+        return false;
+    }
+
+    std::error_code ec;
+    if (const auto size = std::filesystem::file_size(ARCHIVE_FILE, ec); !ec) m_metrics.bytes_written += size;
 
-    if (!imported_tasks.empty()) {
-        unsigned short max_imported_id = std::ranges::max(imported_tasks, {}, &Task::id).id;
-        m_prev_id = std::max(m_prev_id, static_cast<unsigned short>(max_imported_id + 1));
+    for (const size_t position : positions) {
+        UnindexTask(m_tasks[position]);
+        m_id_index.erase(m_tasks[position].id);
     }
 
-    SortIndirectly();
-    std::cout << "✅ Successfully imported " << imported_tasks.size() << " tasks from " << file_path << "!\n";
+    m_tasks.Erase(positions);
+    ReindexFrom(positions.front());
+
+    // The archive is append-only, so the history restarts here: an undo past it would revive tasks it still holds
+    m_store_changed = true;
+    m_batch_changed = false;
+    history.clear();
+    if (!m_one_shot) PushHistory();
+
+    return true;
+}
+
+void Manager::AutoArchive()
+{
+    LoadConfig();
+
+    const auto days = config.value("auto_archive_days", std::uint64_t{0});
+    if (days == 0) return;
+
+    using namespace std::chrono;
+    const year_month_day cutoff_day{floor<std::chrono::days>(system_clock::now()) - std::chrono::days{days}};
+    const std::uint32_t cutoff = static_cast<std::uint32_t>(static_cast<int>(cutoff_day.year())) * 10000
+                               + static_cast<unsigned>(cutoff_day.month()) * 100 + static_cast<unsigned>(cutoff_day.day());
+
+    // The due-week counters tell whether anything is old enough without looking at a single task
+    const bool any_due = std::ranges::any_of(m_counters.DueWeeks(), [cutoff](const auto& week) {
+        return week.first < cutoff && week.second[static_cast<size_t>(Status::Completed)] > 0;
+    });
+    if (!any_due) return;
+
+    size_t archived = 0;
+    if (ArchiveTasks(cutoff, archived) && archived > 0) {
+        m_out << Icon("🗄️  ") << "Auto-archive: " << archived << " completed task(s) due before " << FormatDate(cutoff)
+              << " moved to `" << ARCHIVE_FILE << "`.\n";
+    }
 }
 
 void Manager::Config()
@@ -1252,115 +2400,302 @@ void Manager::Config()
         return;
     }
 
+    LoadConfig();
+
     if (FlagUsed(Flag::DefaultPriority)) {
-        std::string priority = m_flags[Flag::DefaultPriority][0];
+        std::string priority(m_flags[Flag::DefaultPriority][0]);
         if (GetPriority(priority) == Priority::Invalid) {
             PrintInvalidValuesError("default-priority", priority, "`high`, `medium`, `low`, or `none`");
             return;
         }
         config["default_priority"] = priority;
+    } else if (FlagUsed(Flag::AutoArchive)) {
+        size_t days;
+        if (!ParseCount(Flag::AutoArchive, days)) return;
+        config["auto_archive_days"] = days;
     } else {
-        PrintInvalidFlagsError("config", {"default-priority", "colors"});
+        PrintInvalidFlagsError(Command::Config);
         return;
     }
 
     SaveConfig();
-    std::cout << "✅ Configuration updated successfully!\n";
+    m_out << Icon("✅ ") << "Configuration updated successfully!\n";
+}
+
+void Manager::Stats()
+{
+    if (m_flags.size() > static_cast<size_t>(FlagUsed(Flag::Json) + FlagUsed(Flag::Memory))) {
+        PrintInvalidFlagsError(Command::Stats);
+        return;
+    }
+
+    if (FlagUsed(Flag::Memory)) return PrintMemoryStats();
+
+    size_t history_tasks = 0;
+    for (const auto &state : history) history_tasks += state->size();
+
+    // On a server the read-only commands ran on the readers, their metrics are added to the writer's
+    CommandMetrics metrics = m_metrics;
+    if (m_read_metrics) metrics.Merge(m_read_metrics());
+
+    // Store commits happen on the persistence thread, which keeps its own byte count
+    std::uint64_t bytes_written = metrics.bytes_written;
+    if (m_store_writer) bytes_written += m_store_writer->Stats().bytes_written;
+
+    // And the paged store counts the pages it reads
+    std::uint64_t bytes_read = metrics.bytes_read;
+    if (m_paged) bytes_read += m_paged->BytesRead();
+
+    const auto to_us = [](const std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    if (FlagUsed(Flag::Json)) {
+        json commands = json::object();
+        for (const auto &spec : command_specs) {
+            const LatencyHistogram &latency = metrics.latency[static_cast<size_t>(spec.command)];
+            if (latency.Count() == 0) continue;
+
+            commands[std::string(spec.name)] = {
+                {"count", latency.Runs()},
+                {"timed", latency.Count()},
+                {"p50_us", to_us(latency.Percentile(0.50))},
+                {"p90_us", to_us(latency.Percentile(0.90))},
+                {"p99_us", to_us(latency.Percentile(0.99))},
+                {"max_us", to_us(latency.Max())},
+                {"mean_us", to_us(latency.Total()) / static_cast<double>(latency.Count())}
+            };
+        }
+
+        json stats = {
+            {"commands", commands},
+            {"rows", {{"scanned", metrics.rows_scanned}, {"returned", metrics.rows_returned}}},
+            {"bytes", {{"read", bytes_read}, {"written", bytes_written}}},
+            {"history", {{"entries", history.size()}, {"tasks", history_tasks}}}
+        };
+
+        if (m_paged) {
+            const BufferPoolStats& pool = m_paged->Pool().Stats();
+            stats["pool"] = {{"pages", m_paged->PageCount()}, {"capacity", m_paged->Pool().Capacity()},
+                             {"resident", m_paged->Pool().size()}, {"hits", pool.hits}, {"misses", pool.misses},
+                             {"evictions", pool.evictions}};
+        }
+
+        m_out << stats.dump(4) << "\n";
+        return;
+    }
+
+    m_out << "\n" << Icon("📊 ") << "Command latency in µs (since the session started):\n";
+    m_out << "  " << std::left << std::setw(10) << "command" << std::right << std::setw(10) << "count"
+          << std::setw(11) << "p50" << std::setw(11) << "p90" << std::setw(11) << "p99"
+          << std::setw(11) << "max" << std::setw(11) << "mean" << "\n";
+
+    bool any = false;
+    m_out << std::fixed << std::setprecision(1);
+    for (const auto &spec : command_specs) {
+        const LatencyHistogram &latency = metrics.latency[static_cast<size_t>(spec.command)];
+        if (latency.Count() == 0) continue;
+        any = true;
+
+        m_out << "  " << std::left << std::setw(10) << spec.name << std::right << std::setw(10) << latency.Runs()
+              << std::setw(11) << to_us(latency.Percentile(0.50)) << std::setw(11) << to_us(latency.Percentile(0.90))
+              << std::setw(11) << to_us(latency.Percentile(0.99)) << std::setw(11) << to_us(latency.Max())
+              << std::setw(11) << to_us(latency.Total()) / static_cast<double>(latency.Count()) << "\n";
+    }
+    m_out << std::defaultfloat;
+    if (!any) m_out << "  (no commands yet)\n";
+
+    m_out << Icon("📦 ") << "Rows: " << metrics.rows_scanned << " scanned, " << metrics.rows_returned << " returned\n";
+    m_out << Icon("💾 ") << "Bytes: " << bytes_read << " read, " << bytes_written << " written\n";
+    m_out << Icon("🕘 ") << "History: " << history.size() << " snapshot(s) holding " << history_tasks << " task(s)\n";
+
+    if (m_paged) {
+        const BufferPoolStats& pool = m_paged->Pool().Stats();
+        m_out << Icon("📄 ") << "Pool: " << m_paged->Pool().size() << " of " << m_paged->Pool().Capacity() << " frame(s) in use for "
+              << m_paged->PageCount() << " page(s), " << pool.hits << " hit(s), " << pool.misses << " miss(es), "
+              << pool.evictions << " eviction(s)\n";
+    }
 }
 
-void Manager::Help()
+void Manager::PrintMemoryStats()
 {
-    std::cout << "\n📖 Task Manager CLI - Comprehensive Help Guide\n";
-    std::cout << "=============================================\n";
+    struct Subsystem
+    {
+        std::string_view name;
+        MemoryUsage memory;
+        size_t objects;
+        std::string_view unit;
+    };
 
-    // 📌 Task Management Commands
-    std::cout << "📌 Task Management Commands:\n";
-    std::cout << "  ➕ `add`        - Add a new task (Requires: --description) [Optional: --priority, --due, --tags]\n";
-    std::cout << "  ✏️  `edit`       - Modify a task (Requires: --id) [Optional: --description, --priority, --due, --tags, --status]\n";
-    std::cout << "  🗑  `delete`     - Remove a task (Requires: --id)\n";
-    std::cout << "  ✅ `complete`   - Mark a task as completed (Requires: --id)\n\n";
+    size_t flag_values = 0;
+    for (const auto &[flag, values] : m_flags) flag_values += values.size();
+
+    const std::array<Subsystem, 9> subsystems = {{
+        {"tasks", m_task_memory.Usage(), m_tasks.size(), "tasks"},
+        {"id_index", m_index_memory.Usage(), m_id_index.size(), "entries"},
+        {"pending", m_pending_memory.Usage(), m_pending.size(), "queued"},
+        {"counters", m_counter_memory.Usage(), m_counters.DueWeeks().size(), "due weeks"},
+        {"tags", m_tag_memory.Usage(), m_tags.size(), "tags"},
+        {"history", m_history_memory.Usage(), history.size(), "snapshots"},
+        {"flags", m_flag_memory.Usage(), flag_values, "values"},
+        {"pool", m_pool_memory.Usage(), m_paged ? m_paged->Pool().size() : 0, "pages"},
+        {"config", ConfigMemory().Usage(), config.size(), "settings"}    // Shared by every manager of the process
+    }};
+
+    size_t total_bytes = 0, total_peak = 0, total_allocations = 0;
+    for (const auto &subsystem : subsystems) {
+        total_bytes += subsystem.memory.bytes;
+        total_peak += subsystem.memory.peak_bytes;
+        total_allocations += subsystem.memory.allocations;
+    }
+
+    if (FlagUsed(Flag::Json)) {
+        json memory = json::object();
+        for (const auto &subsystem : subsystems) {
+            memory[std::string(subsystem.name)] = {
+                {"bytes", subsystem.memory.bytes},
+                {"peak_bytes", subsystem.memory.peak_bytes},
+                {"allocations", subsystem.memory.allocations},
+                {"objects", subsystem.objects}
+            };
+        }
+        memory["tasks"]["text_bytes"] = m_tasks.LiveBytes();
+        memory["tasks"]["garbage_bytes"] = m_tasks.GarbageBytes();
+        memory["total"] = {{"bytes", total_bytes}, {"peak_bytes", total_peak}, {"allocations", total_allocations}};
+
+        m_out << json{{"memory", memory}}.dump(4) << "\n";
+        return;
+    }
+
+    m_out << "\n" << Icon("🧮 ") << "Memory held by each subsystem (live heap bytes, as requested from the allocator):\n";
+    m_out << "  " << std::left << std::setw(10) << "subsystem" << std::right << std::setw(14) << "bytes"
+          << std::setw(14) << "peak" << std::setw(13) << "allocations" << std::setw(12) << "objects" << "\n";
+
+    for (const auto &subsystem : subsystems) {
+        m_out << "  " << std::left << std::setw(10) << subsystem.name << std::right
+              << std::setw(14) << subsystem.memory.bytes << std::setw(14) << subsystem.memory.peak_bytes
+              << std::setw(13) << subsystem.memory.allocations << std::setw(12) << subsystem.objects
+              << " " << subsystem.unit << "\n";
+    }
 
-    // 📋 Viewing & Searching Commands
-    std::cout << "📋 Viewing & Searching Commands:\n";
-    std::cout << "  📋 `list`       - Show all tasks (No flags required)\n";
-    std::cout << "  🔍 `search`     - Find tasks by description or tags (Requires: --description OR --tags)\n";
-    std::cout << "  🔎 `filter`     - Filter tasks by status, priority, or due date (Use one of: --status, --priority, --due & --to)\n";
-    std::cout << "  🔀 `sort`       - Sort tasks (Requires: --by) [Optional: --order]\n\n";
+    m_out << "  " << std::left << std::setw(10) << "total" << std::right << std::setw(14) << total_bytes
+          << std::setw(14) << total_peak << std::setw(13) << total_allocations << "\n";
+    m_out << Icon("🧹 ") << "Task text: " << m_tasks.LiveBytes() << " bytes in use, " << m_tasks.GarbageBytes()
+          << " left behind by edits and deletes\n";
+}
+
+void Manager::Help() const
+{
+    m_out << "\n" << Icon("📖 ") << "Task Manager CLI - Comprehensive Help Guide\n";
+    m_out << "=============================================\n";
+
+    // Commands, grouped by section, straight from the registry
+    for (size_t section = 0; section < help_section_titles.size(); section++) {
+        m_out << Plain(help_section_titles[section]) << "\n";
 
-    // 🏷️ Tag Management Commands
-    std::cout << "🏷️ Tag Management:\n";
-    std::cout << "  🏷️  `tag` --list               - Show all used tags (No other flags required)\n";
-    std::cout << "  🏷️  `tag` --id N --add tag     - Add a tag to a task (Requires: --id & --add)\n";
-    std::cout << "  🏷️  `tag` --id N --remove tag  - Remove a tag from a task (Requires: --id & --remove)\n\n";
+        for (const auto &spec : command_specs) {
+            if (static_cast<size_t>(spec.section) != section) continue;
 
-    // 🔄 Undo & File Commands
-    std::cout << "🔄 Undo & File Management:\n";
-    std::cout << "  🔄 `undo`       - Revert the last change (No flags required)\n";
-    std::cout << "  📂 `export`     - Save tasks to a file (Requires: --file)\n";
-    std::cout << "  📥 `import`     - Load tasks from a file (Requires: --file)\n\n";
+            m_out << "  " << Icon(spec.icon) << std::left << std::setw(13) << "`" + std::string(spec.name) + "`"
+                  << "- " << spec.summary << "\n";
+            if (!spec.note.empty()) m_out << "     " << spec.note << "\n";
+        }
 
-    // ⚙️ Configuration Commands
-    std::cout << "⚙️ Configuration:\n";
-    std::cout << "  ⚙️ `config --default-priority [high|medium|low|none]` - Set default priority for new tasks\n\n";
+        m_out << "\n";
+    }
+
+    // 📜 Scripting
+    m_out << Icon("📜 ") << "Scripting:\n";
+    m_out << "  " << Icon("📜 ") << "`tasks --batch FILE` / `tasks -` - Run one command per line from a file / a pipe,\n";
+    m_out << "     without prompt or emoji, committed as a single undoable change\n";
+    m_out << "  " << Icon("🛰️  ") << "`tasks --serve PATH` - Serve commands to many clients over a Unix socket, one request\n";
+    m_out << "     per line (plain or {\"command\": ...} JSON), each reply framed as `<length>\\n<body>`\n";
+    m_out << "  " << Icon("🗄️  ") << "`tasks --pool N ...` - Leave the tasks on disk, read through a pool of N pages of 64 KiB.\n";
+    m_out << "     These need the tasks in memory and are refused:";
+
+    // Listed from `RunsPaged`, so the help cannot drift from what is refused
+    bool first_refused = true;
+    for (const auto &spec : command_specs) {
+        if (!RunsPaged(spec.command)) {
+            m_out << (first_refused ? " `" : ", `") << spec.name << "`";
+            first_refused = false;
+            continue;
+        }
 
-    // 🆘 General Commands
-    std::cout << "🆘 General Commands:\n";
-    std::cout << "  🆘 `help`       - Show this guide\n";
-    std::cout << "  ❌ `exit`       - Exit the Task Manager\n\n";
+        for (const Flag flag : spec.flags) {
+            if (RunsPaged(spec.command, flag)) continue;
+            m_out << (first_refused ? " `" : ", `") << spec.name << " --" << GetFlagSpec(flag).name << "`";
+            first_refused = false;
+        }
+    }
+    m_out << "\n\n";
 
     // 🚩 Flags and Usage
-    std::cout << "🚩 Flags and Usage:\n";
-    std::cout << "     --description [TEXT]                 - Description of the task (Required for `add`)\n";
-    std::cout << "     --priority [high|medium|low|none]    - Task priority (Optional for `add`, `edit`, `filter`)\n";
-    std::cout << "     --due [YYYY-MM-DD]                   - Due date of the task (Optional for `add`, `edit`, `filter`)\n";
-    std::cout << "     --to [YYYY-MM-DD]                    - End date for filtering (Used with `--due` in `filter`)\n";
-    std::cout << "     --tags [tag1 tag2 ...]               - Tags for categorization (Optional for `add`, `edit`)\n";
-    std::cout << "     --id [NUMBER]                        - Specify task ID (Required for `edit`, `delete`, `complete`, `tag`)\n";
-    std::cout << "     --status [pending|completed]         - Change task status (For `edit`, `filter`)\n";
-    std::cout << "     --by [priority|due|id|status]        - Sorting criteria (Required for `sort`)\n";
-    std::cout << "     --order [asc|desc]                   - Sorting order (Default: asc)\n";
-    std::cout << "     --add [TAG]                          - Add a tag to a task (Used with `tag --id`)\n";
-    std::cout << "     --remove [TAG]                       - Remove a tag from a task (Used with `tag --id`)\n";
-    std::cout << "     --list                               - List all available tags (Used with `tag` command)\n";
-    std::cout << "     --file [filename]                    - Specify file name for `import` and `export`\n\n";
+    m_out << Icon("🚩 ") << "Flags and Usage:\n";
+    for (const auto &spec : flag_specs) {
+        std::string usage = "--" + std::string(spec.name);
+        if (!spec.argument.empty()) usage += " " + std::string(spec.argument);
+
+        m_out << "     " << std::left << std::setw(36) << usage << " - " << spec.summary << "\n";
+    }
+    m_out << "\n";
 
     // Shortcuts
 
     // 💡 Examples
-    std::cout << "💡 Examples:\n";
-    std::cout << "  ➕ Add a new task:\n";
-    std::cout << "     tasks add --description \"Finish project\" --priority high --due 2025-02-10 --tags work urgent\n";
-    std::cout << "  🗑  Delete a task:\n";
-    std::cout << "     tasks delete --id 3\n";
-    std::cout << "  ✅ Mark a task as completed:\n";
-    std::cout << "     tasks complete --id 5\n";
-    std::cout << "  🔍 Search tasks by tag:\n";
-    std::cout << "     tasks search --tags important\n";
-    std::cout << "  🔀 Sort tasks by priority (descending):\n";
-    std::cout << "     tasks sort --by priority --order desc\n";
-    std::cout << "  🏷️  Add a tag to a task:\n";
-    std::cout << "     tasks tag --id 3 --add important\n";
-    std::cout << "  🏷️  Remove a tag from a task:\n";
-    std::cout << "     tasks tag --id 3 --remove urgent\n";
-    std::cout << "  📂 Export tasks to a file:\n";
-    std::cout << "     tasks export --file tasks.json\n";
-    std::cout << "  📥 Import tasks from a file:\n";
-    std::cout << "     tasks import --file tasks.csv\n";
-    std::cout << "  🏷️  List all tags:\n";
-    std::cout << "     tasks tag --list\n";
-
-    std::cout << "\n✨ Enjoy using Task Manager CLI! 🚀\n";
+    m_out << Icon("💡 ") << "Examples:\n";
+    m_out << "  " << Icon("➕ ") << "Add a new task:\n";
+    m_out << "     tasks add --description \"Finish project\" --priority high --due 2025-02-10 --tags work urgent\n";
+    m_out << "  " << Icon("🗑  ") << "Delete a task:\n";
+    m_out << "     tasks delete --id 3\n";
+    m_out << "  " << Icon("✅ ") << "Mark a task as completed:\n";
+    m_out << "     tasks complete --id 5\n";
+    m_out << "  " << Icon("✅ ") << "Close out a sprint in one go:\n";
+    m_out << "     tasks complete --id 1 5 9-200\n";
+    m_out << "  " << Icon("🗑  ") << "Delete every completed task that was due before 2025:\n";
+    m_out << "     tasks delete --where status=completed \"due<2025-01-01\"\n";
+    m_out << "  " << Icon("🔍 ") << "Search tasks by tag:\n";
+    m_out << "     tasks search --tags important\n";
+    m_out << "  " << Icon("📋 ") << "Show the second page of 20 tasks:\n";
+    m_out << "     tasks list --limit 20 --offset 20\n";
+    m_out << "  " << Icon("📋 ") << "Show the 5 most important tasks:\n";
+    m_out << "     tasks list --top 5 --by priority\n";
+    m_out << "  " << Icon("👉 ") << "Show the 3 tasks to do next:\n";
+    m_out << "     tasks next --top 3\n";
+    m_out << "  " << Icon("📈 ") << "Count the tasks for a dashboard:\n";
+    m_out << "     tasks report --json\n";
+    m_out << "  " << Icon("🔀 ") << "Sort tasks by priority (descending):\n";
+    m_out << "     tasks sort --by priority --order desc\n";
+    m_out << "  " << Icon("🏷️  ") << "Add a tag to a task:\n";
+    m_out << "     tasks tag --id 3 --add important\n";
+    m_out << "  " << Icon("🏷️  ") << "Remove a tag from a task:\n";
+    m_out << "     tasks tag --id 3 --remove urgent\n";
+    m_out << "  " << Icon("📂 ") << "Export tasks to a file:\n";
+    m_out << "     tasks export --file tasks.json\n";
+    m_out << "  " << Icon("📥 ") << "Import tasks from a file:\n";
+    m_out << "     tasks import --file tasks.csv\n";
+    m_out << "  " << Icon("📥 ") << "Import several shards at once:\n";
+    m_out << "     tasks import --file a.csv b.json c.csv.gz\n";
+    m_out << "  " << Icon("🗄️  ") << "Archive the tasks completed and due before 2025, then search them too:\n";
+    m_out << "     tasks archive --before 2025-01-01\n";
+    m_out << "     tasks search --tags work --include-archived\n";
+    m_out << "  " << Icon("🏷️  ") << "List all tags:\n";
+    m_out << "     tasks tag --list\n";
+
+    m_out << "\n" << Icon("✨ ") << "Enjoy using Task Manager CLI! " << Icon("🚀") << "\n";
 }
 
 /* --------------------Command Handling-------------------- */
 
-RunStatus Manager::HandleCommand(const size_t argc, const std::vector<std::string> &argv)
+RunStatus Manager::HandleCommand(const size_t argc, const std::vector<std::string_view> &argv)
 {
-    std::string command_str = argv[0];
-    ToLower(command_str);
-    const Command command = GetCommand(command_str);
+    if (m_recorder && !m_recorder->Record(argc, argv)) {
+        m_err << Icon("⚠️ ") << "Not recorded in the trace: a word holds a `\"` or a line break, or is empty.\n";
+    }
+    m_failed = false;
+
+    // Lookups ignore case, so the command word is never copied or lowercased
+    const Command command = GetCommand(argv[0]);
     if (command == Command::None) {
-        PrintCommandNotFoundError(command_str);
+        PrintCommandNotFoundError(argv[0]);
         return RunStatus::Run;
     }
 
@@ -1369,19 +2704,44 @@ RunStatus Manager::HandleCommand(const size_t argc, const std::vector<std::strin
         return RunStatus::Run;
     }
 
+    // `--sync` is not a flag of the command itself, it asks for the command's changes to reach the disk
+    m_sync_requested = m_flags.contains(Flag::Sync);
+    m_flags.erase(Flag::Sync);
+
     if (command == Command::Exit) {
         PrintExitMessage();
         return RunStatus::Exit;
     }
 
-    ExecuteCommand(command, argc, argv);
+    ExecuteCommand(command, argv);
+
+    // A one-shot process exits before the garbage matters
+    if (!m_one_shot && m_tasks.Sparse()) CompactTasks();
+
+    // Published before the command returns, so a client that saw the reply reads the change
+    if (m_publishing && m_store_changed) PublishSnapshot();
+
+    // Outside a batch every command is persisted on its own
+    if (!m_in_batch) SaveStore();
 
     ClearFlagMap();
     return RunStatus::Run;
 }
 
-void Manager::ExecuteCommand(const Command &command, const size_t argc, const std::vector<std::string> &argv)
+void Manager::ExecuteCommand(const Command &command, const std::vector<std::string_view> &argv)
 {
+    if (m_paged && !RunsPaged(command)) {
+        PrintArgumentError(argv[0], "needs the tasks in memory, run it without `--pool`.");
+        return;
+    }
+
+    // Fast commands are only timed now and then, see `LatencyHistogram`
+    LatencyHistogram &latency = m_metrics.latency[static_cast<size_t>(command)];
+    const bool timed = latency.Due();
+    const auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+    if (command != Command::Help && command != Command::Config && command != Command::Stats) LoadStore();
+
     switch (command) {
         case Command::Add:      Add();                  break;
         case Command::List:     List();                 break;
@@ -1391,61 +2751,153 @@ void Manager::ExecuteCommand(const Command &command, const size_t argc, const st
         case Command::Search:   Search();               break;
         case Command::Filter:   Filter();               break;
         case Command::Sort:     Sort();                 break;
+        case Command::Next:     Next();                 break;
+        case Command::Report:   Report();               break;
         case Command::Tag:      Tag();                  break;
         case Command::Undo:     Undo();                 break;
         case Command::Export:   Export();               break;
         case Command::Import:   Import();               break;
+        case Command::Archive:  Archive();              break;
         case Command::Config:   Config();               break;
+        case Command::Stats:    Stats();                break;
         case Command::Help:     Help();                 break;
         default:                                        break;
     }
+
+    if (timed) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        latency.Record(static_cast<std::uint64_t>(elapsed.count()));
+    }
+}
+
+/* --------------------Batch Execution-------------------- */
+
+void Manager::BeginBatch()
+{
+    m_in_batch = true;
+    m_batch_changed = false;
+    m_config_changed = false;
+}
+
+void Manager::EndBatch()
+{
+    m_in_batch = false;
+
+    if (m_batch_changed) AddToHistory();
+    if (m_config_changed) SaveConfig();
+    SaveStore();
+
+    m_batch_changed = false;
+    m_config_changed = false;
+}
+
+bool Manager::HandleOneShotCommand(const std::vector<std::string> &argv)
+{
+    m_one_shot = true;
+
+    const std::vector<std::string_view> args(argv.begin(), argv.end());
+
+    // The store is written by `EndBatch`, a failed write fails the command too
+    BeginBatch();
+    HandleCommand(args.size(), args);
+    EndBatch();
+
+    return !m_failed;
+}
+
+/* --------------------Snapshot Reads-------------------- */
+
+void Manager::PublishSnapshots()
+{
+    LoadStore();
+    m_publishing = true;
+    PublishSnapshot();
+}
+
+void Manager::PublishSnapshot()
+{
+    // Readers get the tasks already sorted, so they never have to sort a copy of their own
+    if (!m_in_order) SortIndirectly();
+
+    m_snapshot.store(std::make_shared<const TaskSnapshot>(++m_snapshot_version, m_tasks, m_prev_sort));
+}
+
+bool Manager::IsReadOnly(const Command command)
+{
+    switch (command) {
+        case Command::List:
+        case Command::Search:
+        case Command::Filter:
+        case Command::Next:
+        case Command::Report:
+        case Command::Export:
+        case Command::Help:
+        case Command::Exit:
+        case Command::None:
+            return true;
+        default:
+            return false;
+    }
+}
+
+RunStatus Manager::HandleReadCommand(const TaskSnapshot &snapshot, const size_t argc, const std::vector<std::string_view> &argv)
+{
+    if (!IsReadOnly(GetCommand(argv[0]))) {
+        PrintArgumentError(argv[0], "changes the tasks and cannot run on a snapshot.");
+        return RunStatus::Run;
+    }
+
+    if (snapshot.version != m_snapshot_version) {
+        m_tasks = snapshot.tasks;
+        m_prev_sort = snapshot.sort;
+        m_snapshot_version = snapshot.version;
+        RebuildIndexes();
+    }
+
+    // The tasks always come from the writer, a reader never loads or saves the store itself
+    m_store_loaded = true;
+    m_in_order = true;
+
+    return HandleCommand(argc, argv);
 }
 
 /* --------------------Flag-Value Map Handling-------------------- */
 
-bool Manager::InitFlagMap(const size_t argc, const std::vector<std::string> &argv)
+bool Manager::InitFlagMap(const size_t argc, const std::vector<std::string_view> &argv)
 {
     for (size_t i{1}; i < argc; i++) {
-        std::string flag_str;
-
-        if (IsFlag(argv[i])) {
-            flag_str = argv[i].substr(2);
-        } else {
+        if (!IsFlag(argv[i])) {
             PrintArgumentError(argv[i], "is not a valid flag or was used incorrectly.");
             return false;
         }
 
-        ToLower(flag_str);
-        Flag flag = GetFlag(flag_str);
+        const std::string_view flag_str = argv[i].substr(2);
+        const Flag flag = GetFlag(flag_str);
         if (flag == Flag::None) {
-            PrintArgumentError("--" + flag_str, "is not recognized.");
+            PrintArgumentError(argv[i], "is not recognized.");
             return false;
         }
 
         if (i + 1 >= argc || IsFlag(argv[i + 1])) {
-            if (flag_str == "list") {
-                m_flags[flag] = {"list"};
+            if (GetFlagSpec(flag).argument.empty()) {
+                m_flags[flag] = {GetFlagSpec(flag).name};
                 continue;
             }
-            PrintArgumentError("--" + flag_str, "is missing a required value.");
+            PrintArgumentError(argv[i], "is missing a required value.");
             return false;
         }
 
         i++;
 
-        std::vector<std::string>& values = m_flags[flag];
-        std::string arg = argv[i];
-
-        if (flag != Flag::Description)
-            ToLower(arg);
+        FlagValues& values = m_flags[flag];
 
         while (i < argc && !IsFlag(argv[i])) {
             values.push_back(argv[i]);
             i++;
         }
 
-        if (flag != Flag::Tags && values.size() > 1) {
-            PrintArgumentError("--" + flag_str, "only accepts **one** value. Use `--tags tag1 tag2 ...` for multiple values.");
+        if (!GetFlagSpec(flag).multiple && values.size() > 1) {
+            PrintArgumentError("--" + std::string(flag_str), "only accepts **one** value. Use `--tags tag1 tag2 ...` for multiple values.");
             return false;
         }
 
@@ -1464,38 +2916,46 @@ inline void Manager::ClearFlagMap()
 
 static constexpr auto HELP_HINT = "🔹 Type 'help' for more details.\n";
 
-void Manager::PrintCommandNotFoundError(const std::string &command)
+void Manager::PrintCommandNotFoundError(const std::string_view command)
 {
-    std::cout << "\n❌ Error: Unknown command → `" << command << "`\n"
-              << HELP_HINT << "\n";
+    Fail(m_out) << "\n" << Icon("❌ ") << "Error: Unknown command → `" << command << "`\n"
+          << Plain(HELP_HINT) << "\n";
 }
 
-void Manager::PrintTaskNotFoundError(const std::string& id) {
-    std::cout << "❌ Error: Task with ID `" << id << "` not found.\n";
+void Manager::PrintTaskNotFoundError(const std::string_view id) {
+    Fail(m_out) << Icon("❌ ") << "Error: Task with ID `" << id << "` not found.\n";
 }
 
-void Manager::PrintInvalidFlagsError(const std::string& command, const std::vector<std::string>& valid_flags)
+void Manager::PrintInvalidFlagsError(const Command& command)
 {
+    const CommandSpec& spec = GetCommandSpec(command);
+
     std::ostringstream oss;
-    oss << "\n❌ Error: Invalid flags used with the `" << command << "` command.\n"
-        << "🔹 Allowed flags: ";
+    oss << "\n" << Icon("❌ ") << "Error: Invalid flags used with the `" << spec.name << "` command.\n"
+        << Icon("🔹 ") << "Allowed flags: ";
 
-    for (size_t i = 0; i < valid_flags.size(); i++) {
-        oss << "`--" << valid_flags[i] << "`" << (i + 1 < valid_flags.size() ? ", " : "");
+    for (const Flag* flag = spec.flags.begin(); flag != spec.flags.end(); flag++) {
+        oss << "`--" << GetFlagSpec(*flag).name << "`" << (flag + 1 != spec.flags.end() ? ", " : "");
     }
 
-    oss << "\n" << HELP_HINT << "\n";
-    std::cout << oss.str();
+    oss << "\n" << Plain(HELP_HINT) << "\n";
+    Fail(m_out) << oss.str();
+}
+
+void Manager::PrintInvalidValuesError(const std::string_view flag, const std::string_view value, const std::string_view expected)
+{
+    Fail(m_out) << "\n" << Icon("❌ ") << "Error: Invalid value `" << value << "` for flag `--" << flag << "`.\n"
+          << Icon("🔹 ") << "Expected: " << expected << "\n"
+          << Plain(HELP_HINT) << "\n";
 }
 
-void Manager::PrintInvalidValuesError(const std::string& flag, const std::string& value, const std::string& expected)
+void Manager::PrintArgumentError(const std::string_view arg, const std::string_view message)
 {
-    std::cout << "\n❌ Error: Invalid value `" << value << "` for flag `--" << flag << "`.\n"
-              << "🔹 Expected: " << expected << "\n"
-              << HELP_HINT << "\n";
+    Fail(m_out) << "\n" << Icon("❌ ") << "Error: `" << arg << "` " << message << "\n" << Plain(HELP_HINT) << "\n";
 }
 
-void Manager::PrintArgumentError(const std::string& arg, const std::string& message)
+std::ostream& Manager::Fail(std::ostream& stream)
 {
-    std::cout << "\n❌ Error: `" << arg << "` " << message << "\n" << HELP_HINT << "\n";
+    m_failed = true;
+    return stream;
 }
@@ -5,50 +5,137 @@
 #ifndef MANAGER_H
 #define MANAGER_H
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <nlohmann/json.hpp>
 
 #include "Tasks.h"
+#include "OutputBuffer.h"
+#include "ColumnWidths.h"
+#include "FlagMap.h"
+#include "TaskQuery.h"
+#include "StoreWriter.h"
+#include "TraceRecorder.h"
+#include "CommandMetrics.h"
+#include "MemoryAccounting.h"
+#include "TaskTable.h"
+#include "PendingQueue.h"
+#include "TaskCounters.h"
+#include "PagedStore.h"
+#include "PlainText.h"
 
 class Manager final
 {
 public:
-    Manager();
-    ~Manager() = default;
+    /* Output goes to the given streams, so managers on different threads never share one */
+    explicit Manager(std::ostream& out = std::cout, std::ostream& err = std::cerr);
+    ~Manager();
+
+    Manager(const Manager&) = delete;
+    Manager& operator=(const Manager&) = delete;
 
     /* Command Handling
      * ------------------------------------------------------------------------------
      * If an invalid command is given, the function informs the user.
      * If a valid command is given, it calls ExecuteCommand to execute the command.
      */
-    RunStatus HandleCommand(size_t argc, const std::vector<std::string> &argv);
+    RunStatus HandleCommand(size_t argc, const std::vector<std::string_view> &argv);
+
+    /* Batch Execution
+     * ------------------------------------------------------------------------------
+     * Commands handled between `BeginBatch` and `EndBatch` are committed together:
+     * the batch produces a single history entry, a single config write and a
+     * single store write.
+     */
+    void BeginBatch();
+    void EndBatch();
+
+    /* One-Shot Execution
+     * ------------------------------------------------------------------------------
+     * Handles a single command for a process that exits right afterwards:
+     * no undo history is kept and the store is written at most once. Returns
+     * false if the command, or writing its changes, reported an error.
+     */
+    bool HandleOneShotCommand(const std::vector<std::string> &argv);
+
+    /* Snapshot Reads
+     * ------------------------------------------------------------------------------
+     * For a process running commands on several threads at once (`tasks --serve`):
+     * - PublishSnapshots  -> Makes this manager the single writer. Every command that
+     *                        changes the tasks then publishes an immutable snapshot of
+     *                        them before it returns.
+     * - Snapshot          -> The latest published snapshot (any thread, never blocks on
+     *                        the writer).
+     * - IsReadOnly        -> Whether a command only reads the tasks.
+     * - HandleReadCommand -> Runs a read-only command on this (reader) manager against
+     *                        a snapshot. The snapshot is only copied in when its version
+     *                        differs from the one the reader last ran against.
+     */
+    void PublishSnapshots();
+    std::shared_ptr<const TaskSnapshot> Snapshot() const { return m_snapshot.load(); }
+    static bool IsReadOnly(Command command);
+    RunStatus HandleReadCommand(const TaskSnapshot &snapshot, size_t argc, const std::vector<std::string_view> &argv);
+
+    /* Bounded Memory
+     * ------------------------------------------------------------------------------
+     * Leaves the tasks on disk (`tasks --pool PAGES`): the store is read in pages
+     * through a buffer pool of `pool_pages` pages (see `PagedStore`), and only the
+     * indexes are built in memory. `list`, `search` and `export` stream the pages,
+     * `next` and `report` run on the indexes; the commands that change the tasks
+     * need them all in memory and are refused. Call before the first command.
+     */
+    void UsePagedStore(size_t pool_pages);
+
+    /* Appends every command handled from now on to the trace (`tasks --record`), nullptr stops */
+    void SetRecorder(TraceRecorder *recorder) { m_recorder = recorder; }
+
+    /* Leaves the emoji decoration out of every message (`tasks --batch`, `tasks -`), the tasks are written as they are */
+    void SetPlainOutput(const bool plain) { m_plain = plain; }
+
+    /* Metrics
+     * ------------------------------------------------------------------------------
+     * - Metrics         -> What this manager's commands measured (its own thread only).
+     * - SetReadMetrics  -> Given to a serving writer: `stats` adds what `gather`
+     *                      returns (the readers' metrics) to the writer's own, since
+     *                      the read-only commands never run on the writer.
+     */
+    const CommandMetrics& Metrics() const { return m_metrics; }
+    void SetReadMetrics(std::function<CommandMetrics()> gather) { m_read_metrics = std::move(gather); }
 private:
     /* Command Execution
      * ------------------------------------------------------------------------------
-     * Calls the corresponding function for the given command.
+     * Calls the corresponding function for the given command and records how long
+     * it took in the command's latency histogram.
      */
-    void ExecuteCommand(const Command &command, size_t argc, const std::vector<std::string> &argv);
+    void ExecuteCommand(const Command &command, const std::vector<std::string_view> &argv);
 
     /* Getter Methods:
      * ------------------------------------------------------------------------------
-     * - GetCommand  -> Converts a string command into a `Command` enum.
-     * - GetFlag     -> Converts a string flag into a `Flag` enum.
+     * - GetCommand  -> Converts a string command (any case) into a `Command` enum.
+     * - GetFlag     -> Converts a string flag (any case) into a `Flag` enum.
      * - GetPriority -> Converts a string priority into a `Priority` enum.
      * - GetStatus   -> Converts a string status into a `Status` enum.
      * - GetOrder    -> Converts a string order into an `Order` enum.
+     * - GetImportMode -> Converts a string import mode into an `ImportMode` enum.
      */
-    static Command GetCommand(const std::string &command_str);
-    static Flag GetFlag(const std::string &flag_str);
-    static Priority GetPriority(const std::string &priority_str);
-    static Status GetStatus(const std::string &status_str);
-    static Order GetOrder(const std::string &order_str);
+    static Command GetCommand(std::string_view command_str);
+    static Flag GetFlag(std::string_view flag_str);
+    static Priority GetPriority(std::string_view priority_str);
+    static Status GetStatus(std::string_view status_str);
+    static Order GetOrder(std::string_view order_str);
+    static ImportMode GetImportMode(std::string_view mode_str);
 
     /* Converter Methods:
      * ------------------------------------------------------------------------------
      * - GetPriorityStr -> Converts a `Priority` enum into a string.
      * - GetFlagStr     -> Converts a `Flag` enum into a string.
      */
-    static std::string GetPriorityStr(const Priority &priority);
+    static std::string_view GetPriorityStr(const Priority &priority);
     static std::string GetFlagStr(const Flag &flag);
 
     /* Helper Methods:
@@ -60,107 +147,251 @@ private:
      * - ToLower            -> Converts a string to lowercase.
      * - SplitQuotedText    -> Converts a quoted text with spaces into a vector of all the words in the expression
      * - SortIndirectly     -> After adding, editing resorts the tasks
-     * - ListIndirectly     -> After search, filtering automatically shows all the tasks
+     * - ListIndirectly     -> After search, filtering automatically shows the matching tasks
+     * - RenderTable        -> Measures the given tasks (records of `tasks`) and renders them as a table
+     * - RenderHeader       -> Renders the top border and the column names
+     * - RenderRow          -> Renders a single task of `tasks`
+     * - RenderFooter       -> Renders the bottom border and flushes the output
+     * - ParseCount         -> Parses the non-negative integer value of a flag
+     * - CompareTasks       -> Compares two tasks by the given sort key
+     * - PartialSortRows    -> Keeps only the first `count` rows in sorted order
      * - ListTags           -> Lists all the tags
+     * - RetagTasks         -> Renames (`--rename`) or merges (`--merge ... --into`) tags through their postings
      * - AddFlagUpdate      -> Updates the task when adding the task
      * - EditFlagUpdate     -> Updates the task when editing the task
+     * - Icon / Plain       -> The icon of a message, and a message that starts with one, as they are
+     *                         written: without the icon if the output is plain
      * - AddToHistory       -> Function that adds the current state to the history for future undo
-     * - LoadConfig         -> Loads config setting from a file
+     * - PushHistory        -> Appends a shared copy of the tasks to the history, the one `SaveStore` hands
+     *                         to the persistence thread
+     * - CompactTasks       -> Rewrites the text pool of the tasks without the garbage, run once deletes
+     *                         and edits have left most of it unused
+     * - FindTask           -> Looks a task up through the ID index, returns `m_tasks.end()` if absent
+     * - IndexTask          -> Adds the task to the tag postings, the column widths, the pending queue and
+     *                         the report counters
+     * - UnindexTask        -> Removes the task from the tag postings, the column widths, the pending queue
+     *                         and the report counters
+     * - ReindexFrom        -> Refreshes the ID index for every task from the given position onwards
+     * - RebuildIndexes     -> Rebuilds the ID index and the tag postings from scratch
+     * - PublishSnapshot    -> Publishes the tasks, in the active sort order, for the readers
+     * - ParseSelection     -> Parses `--id` (IDs and ranges) and `--where` (conditions) into a query
+     * - ParseIdRanges      -> Parses the `--id` values, e.g. `1 5 9-200`
+     * - ParseWhere         -> Parses the `--where` conditions, e.g. `status=completed due<2025-01-01`
+     * - SelectTasks        -> Positions of the tasks the query selects, in store order (false if none)
+     * - UpdateTaskFields   -> Copies the changed fields of an imported task onto an existing one
+     * - MergeImportedTasks -> Joins imported tasks against the ID index and applies the import mode
+     * - ArchiveTasks       -> Appends the completed tasks due before the given packed date (0 = all of them)
+     *                         to the archive and drops them from the store, restarting the history
+     * - AutoArchive        -> Archives the tasks the `auto_archive_days` setting has aged out (on load)
+     * - ParseImportFile    -> Parses one import file into its staging batch (safe to run on any thread)
+     * - LoadConfig         -> Loads config setting from a file (once, on first use)
      * - SaveConfig         -> Writes the config setting to a file
+     * - LoadStore          -> Loads the persisted tasks (once, on first use)
+     * - SaveStore          -> Hands the newest history entry to the persistence thread if the tasks
+     *                         changed since the last save, and waits for the disk under `--sync`
      */
     bool FlagUsed(const Flag &flag) const;
-    static bool IsFlag(const std::string &flag);
-    static void PrintExitMessage();
-    static DateValidationResult ValidateDateFormat(std::string &date);
+    static bool IsFlag(std::string_view flag);
+    void PrintExitMessage() const;
+    static DateValidationResult ValidateDateFormat(auto &date);
     static void ToLower(std::string &str);
-    static void SplitQuotedText(const std::string& input, std::vector<std::string>& output);
-    bool ValidateAddTags(const std::vector<std::string>& values, Task& task);
-    bool ValidateEditTags(const std::vector<std::string>& values, const auto& it);
+    static void SplitQuotedText(std::string_view input, std::vector<std::string>& output);
+    bool ValidateAddTags(const FlagValues& values, Task& task);
+    bool ValidateEditTags(const FlagValues& values, const auto& it);
     void SortIndirectly();
-    void ListIndirectly();
+    void ListIndirectly(const std::vector<const Task*>& rows);
+    void RenderTable(const std::vector<const Task*>& rows, const TaskTable& tasks);
+    void RenderHeader(const TableLayout& layout);
+    void RenderRow(const Task& task, const TaskTable& tasks, const TableLayout& layout);
+    void RenderFooter(const TableLayout& layout);
+    bool ParseCount(const Flag& flag, size_t& count);
+    static bool CompareTasks(const Task& a, const Task& b, const Flag& sort_by);
+    static void PartialSortRows(std::vector<const Task*>& rows, size_t count, const Flag& sort_by, const Order& order);
     void ListTags() const;
-    bool AddFlagUpdate(const Flag& flag, std::vector<std::string>& values, Task& task);
-    bool EditFlagUpdate(const Flag& flag, std::vector<std::string>& values, const auto& it);
+    void RetagTasks();
+    bool AddFlagUpdate(const Flag& flag, const FlagValues& values, Task& task);
+    bool EditFlagUpdate(const Flag& flag, const FlagValues& values, const auto& it);
+    std::string_view Icon(const std::string_view icon) const { return ::Icon(icon, m_plain); }
+    std::string_view Plain(const std::string_view message) const { return m_plain ? Undecorated(message) : message; }
     void AddToHistory();
+    void PushHistory();
+    void CompactTasks();
+    TaskTable::iterator FindTask(unsigned int id);
+    void IndexTask(const Task& task);
+    void IndexTask(const Task& task, const TaskTable& tasks);
+    void UnindexTask(const Task& task);
+    void ReindexFrom(size_t position);
+    void RebuildIndexes();
+    void PublishSnapshot();
+    bool ParseSelection(TaskQuery& query);
+    bool ParseIdRanges(TaskQuery& query);
+    bool ParseWhere(TaskQuery& query);
+    bool SelectTasks(const TaskQuery& query, std::vector<size_t>& positions);
+    bool UpdateTaskFields(Task& task, const Task& imported, const TaskTable& source);
+    ImportSummary MergeImportedTasks(TaskTable& imported_tasks, ImportMode mode);
+    bool ArchiveTasks(std::uint32_t before, size_t& archived);
+    void AutoArchive();
+    static void ParseImportFile(ImportBatch& batch);
     void LoadConfig();
-    void SaveConfig() const;
+    void SaveConfig();
+    void LoadStore();
+    void SaveStore();
+    static bool RunsPaged(Command command);
+    static bool RunsPaged(Command command, Flag flag);
+    void ListPaged(size_t offset, size_t limit, bool full);
 
     /* Error Handling Methods:
      * ------------------------------------------------------------------------------
      * - PrintCommandNotFoundError      -> Prints an error if an invalid command is given.
      * - PrintTaskNotFoundError         -> Prints an error if a task with the given ID doesn't exist.
-     * - PrintInvalidFlagsError         -> Prints an error for invalid flags.
+     * - PrintInvalidFlagsError         -> Prints an error listing the flags a command accepts.
      * - PrintInvalidValuesError        -> Prints an error for invalid flag values.
      * - PrintArgumentError             -> Generic error for argument-related issues.
+     * - Fail                           -> Marks the current command as failed and returns `stream`,
+     *                                     for the errors written in place.
      */
-    static void PrintCommandNotFoundError(const std::string &command);
-    static void PrintTaskNotFoundError(const std::string &id);
-    static void PrintInvalidFlagsError(const std::string& command, const std::vector<std::string>& valid_flags);
-    static void PrintInvalidValuesError(const std::string& flag, const std::string& value, const std::string& expected);
-    static void PrintArgumentError(const std::string& arg, const std::string& message);
+    void PrintCommandNotFoundError(std::string_view command);
+    void PrintTaskNotFoundError(std::string_view id);
+    void PrintInvalidFlagsError(const Command& command);
+    void PrintInvalidValuesError(std::string_view flag, std::string_view value, std::string_view expected);
+    void PrintArgumentError(std::string_view arg, std::string_view message);
+    std::ostream& Fail(std::ostream& stream);
 
     /* Main Functionality Methods:
      * ------------------------------------------------------------------------------
      * - Add      -> Adds a task to the task manager.
-     * - List     -> Lists all available tasks.
+     * - List     -> Lists all available tasks, or one page / the top N of them.
      * - Edit     -> Edits a task by ID.
      * - Delete   -> Deletes a task by ID.
      * - Complete -> Marks a task as completed.
      * - Search   -> Searches for tasks with specific description and tags
      * - Filter   -> Filters the tasks based on status, priority, or date
      * - Sort     -> Sort all the tasks based on id, date, priority, or status
+     * - Next     -> Shows the first pending tasks by priority, due date and ID, from the pending queue
+     * - Report   -> Shows the task counts by status x priority, tag and due week (text or JSON)
      * - Tag      -> Can add, remove tags to certain tasks, or show all the available tags
      * - Undo     -> Undoes the last action made
      * - Export   -> Exports the tasks in a one of these formats: txt/csv/json
      * - Imports  -> Imports the file containing the tasks
+     * - Archive  -> Moves the completed tasks (due before `--before`, if given) to the archive
      * - Config   -> Allows the user to change the default settings of the config
+     * - Stats    -> Shows the command latencies and the row, byte and history counters, or with `--memory`
+     *               the memory of every subsystem (text or JSON)
      * - Help     -> Displays available commands and usage information.
      */
     void Add();
-    void List(bool called_directly=true);
+    void List();
     void Edit();
     void Delete();
     void Complete();
     void Search();
     void Filter();
     void Sort(bool called_directly=true);
+    void Next();
+    void Report();
     void Tag();
     void Undo();
     void Export();
     void Import();
+    void Archive();
     void Config();
-    static void Help();
+    void Stats();
+    void PrintMemoryStats();
+    void Help() const;
 
     /* Flag-Value Processing:
      * ------------------------------------------------------------------------------
      * - InitFlagMap  -> Initializes a flag-value map.
      *                   Each flag (e.g., `--id`) maps to its corresponding value(s).
-     * - ClearFlagMap -> Clears the flag map after processing a command.
+     * - ClearFlagMap -> Clears the flag map after processing a command, keeping its storage.
      */
-    bool InitFlagMap(size_t argc, const std::vector<std::string>& argv);
+    bool InitFlagMap(size_t argc, const std::vector<std::string_view>& argv);
     void ClearFlagMap();
 private:
     /* Member Variables:
      * ------------------------------------------------------------------------------
+     * - `m_*_memory`       -> Counting resources of the tasks, the ID index, the pending queue, the report
+     *                         counters, the tag postings, the undo history, the flag values and the pages
+     *                         of the buffer pool, reported by `stats --memory`
      * - `m_tasks`          -> Stores all tasks.
      * - `m_prev_id`        -> Tracks the last assigned task ID.
-     * - `m_flags`          -> Maps flags to their corresponding values.
-     * - `m_hidden_count`   -> Number of hidden tasks
+     * - `m_flags`          -> Maps flags to their values (views into the current command line)
      * - `m_prev_sort`      -> The previous sorting setting to make sure when new task added follow the same sorting
-     * - `m_tags`           -> Stores all the tags used in the tasks
+     * - `m_tags`           -> Maps every tag in use to the IDs of the tasks carrying it
+     * - `m_id_index`       -> Maps a task ID to its position in `m_tasks` (in `m_paged`, if memory is bounded)
+     * - `m_widths`         -> Widest cell of every table column across all tasks
+     * - `m_pending`        -> The pending tasks in `next` order
+     * - `m_counters`       -> Task counts by status x priority and by due week, shown by `report`
      * - `m_prev_states`    -> All previous states of the program for preforming `undo`
      * - `config`           -> JSON of the config file
+     * - `m_in_batch`       -> Whether history entries and config writes are deferred to `EndBatch`
+     * - `m_batch_changed`  -> Whether a command of the current batch changed the tasks
+     * - `m_config_changed` -> Whether a command of the current batch changed the config
+     * - `m_config_loaded`  -> Whether `config` has been read from disk
+     * - `m_store_loaded`   -> Whether the persisted tasks have been read from disk
+     * - `m_store_changed`  -> Whether the tasks changed since they were last persisted
+     * - `m_store_damaged`  -> Whether the persisted tasks could not be read (they are then never overwritten)
+     * - `m_paged`          -> The store read through a buffer pool instead of `m_tasks`, if memory is bounded
+     * - `m_store_writer`   -> Persistence thread, started by the first save (none for one-shot commands)
+     * - `m_store_sequence` -> Sequence number of the last record handed to `m_store_writer`
+     * - `m_sync_requested` -> Whether the current command was given `--sync`
+     * - `m_recorder`       -> Trace every command is appended to, if recording
+     * - `m_metrics`        -> Latency histograms and counters shown by `stats`
+     * - `m_read_metrics`   -> Gathers the metrics of a server's readers for `stats` (serving writer only)
+     * - `m_one_shot`       -> Whether the process handles a single command, so no undo history is kept
+     * - `m_plain`          -> Whether messages are written without their emoji decoration
+     * - `m_failed`         -> Whether the current command reported an error
+     * - `m_out`, `m_err`   -> Streams every message and table is written to
+     * - `m_output`         -> Reusable buffer the task table is rendered into
+     * - `m_snapshot`       -> Latest snapshot published for the readers (writer only)
+     * - `m_snapshot_version` -> Version of the last snapshot published (writer) or run against (reader)
+     * - `m_publishing`     -> Whether commands publish snapshots, see `PublishSnapshots`
     */
-    unsigned short int m_prev_id{1};
-    unsigned short int m_hidden_count{};
-    std::unordered_map<Flag, std::vector<std::string>> m_flags {};
-    std::unordered_map<std::string, int> m_tags {};
-    std::vector<Task> m_tasks {};
+    CountingResource m_task_memory {};
+    CountingResource m_index_memory {};
+    CountingResource m_pending_memory {};
+    CountingResource m_counter_memory {};
+    CountingResource m_tag_memory {};
+    SharedCountingResource m_history_memory {};
+    CountingResource m_flag_memory {};
+    CountingResource m_pool_memory {};
+
+    unsigned int m_prev_id{1};
+    FlagMap m_flags {&m_flag_memory};
+    std::pmr::unordered_map<std::pmr::string, std::pmr::unordered_set<unsigned int>> m_tags {&m_tag_memory};
+    TaskTable m_tasks {&m_task_memory};
+    std::pmr::unordered_map<unsigned int, size_t> m_id_index {&m_index_memory};
+    ColumnWidths m_widths {};
+    PendingQueue m_pending {&m_pending_memory};
+    TaskCounters m_counters {&m_counter_memory};
     std::pair<Flag, Order> m_prev_sort {std::make_pair(Flag::None, Order::None)};
-    std::deque<std::vector<Task>> history{m_tasks};
-    nlohmann::json config;
+    std::pmr::deque<std::shared_ptr<const TaskTable>> history {&m_history_memory};
+    ConfigJson config;
+    std::ostream &m_out;
+    std::ostream &m_err;
+    OutputBuffer m_output{m_out};
+    std::atomic<std::shared_ptr<const TaskSnapshot>> m_snapshot {};
+    std::uint64_t m_snapshot_version {0};
+    std::unique_ptr<PagedStore> m_paged {};
+    std::unique_ptr<StoreWriter> m_store_writer {};
+    std::uint64_t m_store_sequence {0};
+    TraceRecorder *m_recorder {nullptr};
+    CommandMetrics m_metrics {};
+    std::function<CommandMetrics()> m_read_metrics {};
 
     bool m_in_order {true};
+    bool m_in_batch {false};
+    bool m_batch_changed {false};
+    bool m_config_changed {false};
+    bool m_config_loaded {false};
+    bool m_store_loaded {false};
+    bool m_store_changed {false};
+    bool m_store_damaged {false};
+    bool m_one_shot {false};
+    bool m_plain {false};
+    bool m_failed {false};
+    bool m_publishing {false};
+    bool m_sync_requested {false};
 };
 
 
@@ -0,0 +1,47 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "MemoryAccounting.h"
+
+#include <type_traits>
+
+/* --------------------Counting Resource-------------------- */
+
+template <typename Count>
+void* BasicCountingResource<Count>::do_allocate(const size_t bytes, const size_t alignment)
+{
+    void *pointer = m_upstream->allocate(bytes, alignment);
+
+    const size_t live = m_bytes += bytes;
+    m_allocations++;
+
+    if constexpr (std::is_same_v<Count, size_t>) {
+        if (live > m_peak_bytes) m_peak_bytes = live;
+    } else {
+        size_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    return pointer;
+}
+
+template <typename Count>
+void BasicCountingResource<Count>::do_deallocate(void *pointer, const size_t bytes, const size_t alignment)
+{
+    m_upstream->deallocate(pointer, bytes, alignment);
+
+    m_bytes -= bytes;
+    m_allocations--;
+}
+
+template class BasicCountingResource<size_t>;
+template class BasicCountingResource<std::atomic<size_t>>;
+
+/* --------------------Config-------------------- */
+
+SharedCountingResource& ConfigMemory()
+{
+    static SharedCountingResource resource;
+    return resource;
+}
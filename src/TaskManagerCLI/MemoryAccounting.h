@@ -0,0 +1,95 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef MEMORYACCOUNTING_H
+#define MEMORYACCOUNTING_H
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/* MemoryUsage
+ * ------------------------------------------------------------------------------
+ * What a counting resource holds at one point: live bytes and allocations, plus
+ * the peak byte count.
+ */
+struct MemoryUsage
+{
+    size_t bytes;
+    size_t peak_bytes;
+    size_t allocations;
+};
+
+/* BasicCountingResource
+ * ------------------------------------------------------------------------------
+ * Polymorphic memory resource that passes every request on to its upstream and
+ * keeps count of what is live. A subsystem's containers are built on their own
+ * resource, so `stats --memory` can say how much of the process each of them
+ * holds.
+ * - CountingResource       -> Plain counters: like the containers on it, the
+ *                             resource belongs to one thread.
+ * - SharedCountingResource -> Atomic counters, for memory that is allocated on
+ *                             one thread and may be freed on another.
+ */
+template <typename Count>
+class BasicCountingResource final : public std::pmr::memory_resource
+{
+public:
+    explicit BasicCountingResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()) : m_upstream(upstream) {}
+
+    BasicCountingResource(const BasicCountingResource&) = delete;
+    BasicCountingResource& operator=(const BasicCountingResource&) = delete;
+
+    size_t Bytes() const { return m_bytes; }
+    size_t PeakBytes() const { return m_peak_bytes; }
+    size_t Allocations() const { return m_allocations; }
+    MemoryUsage Usage() const { return {Bytes(), PeakBytes(), Allocations()}; }
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource *m_upstream;
+    Count m_bytes{0};
+    Count m_peak_bytes{0};
+    Count m_allocations{0};
+};
+
+using CountingResource = BasicCountingResource<size_t>;
+using SharedCountingResource = BasicCountingResource<std::atomic<size_t>>;
+
+/* ConfigAllocator
+ * ------------------------------------------------------------------------------
+ * nlohmann's JSON default-constructs its allocators, so it cannot be handed a
+ * resource per value. This stateless allocator sends every node, array and
+ * string of the config JSON to one process-wide counting resource instead. Its
+ * counters are atomic: under `--serve` the writer's config is built on whichever
+ * worker holds the writer and freed on the main thread.
+ */
+SharedCountingResource& ConfigMemory();
+
+template <typename T>
+struct ConfigAllocator
+{
+    using value_type = T;
+
+    ConfigAllocator() = default;
+    template <typename U> ConfigAllocator(const ConfigAllocator<U>&) noexcept {}
+
+    T* allocate(const size_t count) { return static_cast<T*>(ConfigMemory().allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T *pointer, const size_t count) { ConfigMemory().deallocate(pointer, count * sizeof(T), alignof(T)); }
+
+    template <typename U> bool operator==(const ConfigAllocator<U>&) const noexcept { return true; }
+};
+
+using ConfigString = std::basic_string<char, std::char_traits<char>, ConfigAllocator<char>>;
+using ConfigJson = nlohmann::basic_json<std::map, std::vector, ConfigString, bool, std::int64_t, std::uint64_t,
+                                        double, ConfigAllocator>;
+
+#endif //MEMORYACCOUNTING_H
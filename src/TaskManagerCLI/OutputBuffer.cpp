@@ -0,0 +1,62 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "OutputBuffer.h"
+
+#include <charconv>
+
+/* --------------------Consts-------------------- */
+
+// Roughly a full terminal screen of a wide table; big enough for stdio to pass it straight to `write`
+static constexpr size_t SCREENFUL = 1 << 16;
+
+/* --------------------Constructor-------------------- */
+
+OutputBuffer::OutputBuffer(std::ostream &out)
+    : m_out(out)
+{
+    m_buffer.reserve(SCREENFUL + 1024);
+}
+
+/* --------------------Appending-------------------- */
+
+void OutputBuffer::AppendPadded(const std::string_view text, const size_t width)
+{
+    m_buffer.append(text);
+    if (text.size() < width) m_buffer.append(width - text.size(), ' ');
+}
+
+void OutputBuffer::AppendNumber(const unsigned long value, const size_t width)
+{
+    char digits[20];
+    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    AppendPadded(std::string_view(digits, static_cast<size_t>(end - digits)), width);
+}
+
+void OutputBuffer::EndLine()
+{
+    m_buffer.push_back('\n');
+    if (m_buffer.size() >= SCREENFUL) Flush();
+}
+
+void OutputBuffer::Flush()
+{
+    if (m_buffer.empty()) return;
+
+    m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_out.flush();
+    m_buffer.clear();
+}
+
+/* --------------------Helpers-------------------- */
+
+size_t OutputBuffer::DigitCount(unsigned long value)
+{
+    size_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        digits++;
+    }
+    return digits;
+}
@@ -0,0 +1,52 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/* OutputBuffer
+ * ------------------------------------------------------------------------------
+ * Reusable formatting buffer for table output. Text, padding and numbers are
+ * appended in place (numbers through `std::to_chars`) and the buffer is handed
+ * to the stream in one write per screenful. The storage keeps its capacity
+ * between flushes, so rendering allocates nothing once it has warmed up.
+ */
+class OutputBuffer final
+{
+public:
+    explicit OutputBuffer(std::ostream &out);
+    ~OutputBuffer() { Flush(); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /* Appending Methods:
+     * ------------------------------------------------------------------------------
+     * - Append         -> Appends the text as is.
+     * - AppendPadded   -> Appends the text left-aligned in a column of `width` characters.
+     * - AppendNumber   -> Appends an unsigned number left-aligned in a column of `width` characters.
+     * - AppendRepeated -> Appends `count` copies of `c`.
+     * - EndLine        -> Ends the current line and flushes once a screenful has been collected.
+     */
+    void Append(std::string_view text) { m_buffer.append(text); }
+    void AppendPadded(std::string_view text, size_t width);
+    void AppendNumber(unsigned long value, size_t width);
+    void AppendRepeated(char c, size_t count) { m_buffer.append(count, c); }
+    void EndLine();
+
+    /* Writes everything collected so far to the stream */
+    void Flush();
+
+    /* Number of characters needed to print `value` */
+    static size_t DigitCount(unsigned long value);
+private:
+    std::ostream &m_out;
+    std::string m_buffer;
+};
+
+#endif //OUTPUTBUFFER_H
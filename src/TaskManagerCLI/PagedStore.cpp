@@ -0,0 +1,162 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "PagedStore.h"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "StoreFile.h"
+
+/* --------------------Consts-------------------- */
+
+// What `Open` reads at a time while it indexes the store
+static constexpr size_t OPEN_READ_BYTES = PagedStore::READ_AHEAD_PAGES * PagedStore::PAGE_BYTES;
+
+/* --------------------Open / Close-------------------- */
+
+PagedStore::PagedStore(const size_t pool_pages, const allocator_type &allocator)
+    : m_pool(pool_pages), m_allocator(allocator)
+{
+}
+
+PagedStore::~PagedStore()
+{
+    if (m_fd != -1) close(m_fd);
+}
+
+bool PagedStore::Open(const std::string &file_path, unsigned int &next_id, const IndexPage &index)
+{
+    m_fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd == -1) return errno == ENOENT;
+
+    posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // `buffer` holds the file from `buffer_offset` on, `consumed` bytes of it are decoded already
+    std::string buffer;
+    std::uint64_t buffer_offset = 0;
+    size_t consumed = 0;
+
+    const auto read_more = [&] {
+        buffer.erase(0, consumed);
+        buffer_offset += consumed;
+        consumed = 0;
+
+        const size_t kept = buffer.size();
+        buffer.resize(kept + OPEN_READ_BYTES);
+
+        ssize_t count;
+        do count = pread(m_fd, buffer.data() + kept, OPEN_READ_BYTES, static_cast<off_t>(buffer_offset + kept));
+        while (count == -1 && errno == EINTR);
+
+        buffer.resize(kept + static_cast<size_t>(std::max<ssize_t>(count, 0)));
+        m_bytes_read += static_cast<std::uint64_t>(std::max<ssize_t>(count, 0));
+        return count > 0;
+    };
+
+    // Nothing of a store that turns out damaged is kept
+    const auto fail = [this] {
+        m_pages.clear();
+        m_pool.Clear();
+        return false;
+    };
+
+    StoreHeader header;
+    while (!StoreFile::ReadHeader(buffer, header)) {
+        if (!read_more()) return fail();
+    }
+    consumed = header.size;
+
+    m_u16_ids = header.u16_ids;
+    auto page = std::make_shared<TaskTable>(m_allocator);
+    PageEntry entry{header.size, 0, 0, 0};
+
+    for (std::uint32_t i = 0; i < header.count;) {
+        const size_t size = StoreFile::ReadRecord(std::string_view(buffer).substr(consumed), m_u16_ids, *page, m_tags);
+
+        // A record cut off by the end of the buffer is read again once the rest of it is in
+        if (size == 0) {
+            if (!read_more()) return fail();
+            continue;
+        }
+
+        consumed += size;
+        entry.bytes += static_cast<std::uint32_t>(size);
+        entry.count++;
+        i++;
+
+        // The page is decoded already, so it goes to the pool: with room for the whole store, no page is read twice
+        if (entry.bytes >= PAGE_BYTES || i == header.count) {
+            index(*page, entry.first);
+            m_pool.Insert(m_pages.size(), std::move(page));
+            m_pages.push_back(entry);
+
+            page = std::make_shared<TaskTable>(m_allocator);
+            entry = {entry.offset + entry.bytes, 0, 0, entry.first + entry.count};
+        }
+    }
+
+    // Like `StoreFile::Load`, bytes after the last task mean the count is wrong
+    if (consumed != buffer.size() || read_more()) return fail();
+
+    m_task_count = header.count;
+    next_id = header.next_id;
+    return true;
+}
+
+/* --------------------Pages-------------------- */
+
+std::pair<size_t, size_t> PagedStore::Locate(const size_t position) const
+{
+    const auto it = std::ranges::upper_bound(m_pages, position, {}, &PageEntry::first) - 1;
+    return {static_cast<size_t>(it - m_pages.begin()), position - it->first};
+}
+
+PagedStore::Page PagedStore::Fetch(const size_t page)
+{
+    return m_pool.Fetch(page, [this](const size_t number) { return Load(number); });
+}
+
+PagedStore::Page PagedStore::Load(const size_t page)
+{
+    const PageEntry &entry = m_pages[page];
+    if (!ReadAt(entry.offset, entry.bytes, m_buffer)) return nullptr;
+
+    auto table = std::make_shared<TaskTable>(m_allocator);
+    table->reserve(entry.count);
+
+    std::string_view bytes = m_buffer;
+    for (std::uint32_t i = 0; i < entry.count; i++) {
+        const size_t size = StoreFile::ReadRecord(bytes, m_u16_ids, *table, m_tags);
+        if (size == 0) return nullptr;
+        bytes.remove_prefix(size);
+    }
+
+    return table;
+}
+
+void PagedStore::ReadAhead(const size_t first_page, const size_t end_page) const
+{
+    if (first_page >= end_page) return;
+
+    const PageEntry &last = m_pages[end_page - 1];
+    const std::uint64_t begin = m_pages[first_page].offset;
+    posix_fadvise(m_fd, static_cast<off_t>(begin), static_cast<off_t>(last.offset + last.bytes - begin), POSIX_FADV_WILLNEED);
+}
+
+bool PagedStore::ReadAt(const std::uint64_t offset, const size_t size, std::string &buffer)
+{
+    buffer.resize(size);
+
+    for (size_t done = 0; done < size;) {
+        const ssize_t count = pread(m_fd, buffer.data() + done, size - done, static_cast<off_t>(offset + done));
+        if (count > 0) done += static_cast<size_t>(count);
+        else if (count == 0 || errno != EINTR) return false;
+    }
+
+    m_bytes_read += size;
+    return true;
+}
@@ -0,0 +1,115 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef PAGEDSTORE_H
+#define PAGEDSTORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "BufferPool.h"
+#include "TaskTable.h"
+
+/* PagedStore
+ * ------------------------------------------------------------------------------
+ * The task store read in place instead of loaded whole, for processes that must
+ * keep their memory bounded (`tasks --pool PAGES`). The file is the one
+ * `StoreFile` writes: its records are cut into pages of consecutive tasks, each
+ * page closed by the first record that takes it to `PAGE_BYTES` or more, and the
+ * pages are read through a `BufferPool` of `pool_pages` pages.
+ * - Open   -> Streams the file once, handing every page to `index` together with
+ *             the store position of its first task, so the caller can build its
+ *             in-memory indexes. Besides the page directory, only the pages the
+ *             pool has room for are kept (the last ones read). A missing file is
+ *             an empty store, a damaged one makes `Open` return false.
+ * - Locate -> The page of a store position, and the task's index in that page.
+ * - Fetch  -> A page, through the pool. nullptr if it can no longer be read.
+ * - Scan   -> Visits the pages holding positions [first, last) in order, as
+ *             `visit(page, begin, end)` with the slice of the page in the range.
+ *             Up to `2 * READ_AHEAD_PAGES` pages of the range ahead of the scan are
+ *             announced to the kernel, so their reads overlap with the work on
+ *             the current ones.
+ */
+class PagedStore final
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using Page = BufferPool::Page;
+    using IndexPage = std::function<void(const TaskTable &page, size_t first_position)>;
+
+    static constexpr size_t PAGE_BYTES = 64 * 1024;
+    static constexpr size_t READ_AHEAD_PAGES = 16;
+
+    /* The pages in the pool are decoded on `allocator` */
+    explicit PagedStore(size_t pool_pages, const allocator_type &allocator = {});
+    ~PagedStore();
+
+    PagedStore(const PagedStore&) = delete;
+    PagedStore& operator=(const PagedStore&) = delete;
+
+    bool Open(const std::string &file_path, unsigned int &next_id, const IndexPage &index);
+
+    size_t size() const { return m_task_count; }
+    size_t PageCount() const { return m_pages.size(); }
+    std::pair<size_t, size_t> Locate(size_t position) const;
+    Page Fetch(size_t page);
+
+    template <typename Visit>
+    bool Scan(const size_t first, const size_t last, Visit &&visit)
+    {
+        if (first >= std::min(last, m_task_count)) return true;
+
+        const size_t first_page = Locate(first).first;
+        const size_t end_page = Locate(std::min(last, m_task_count) - 1).first + 1;
+
+        for (size_t page = first_page; page < end_page; page++) {
+            // Two windows past the current page are announced up front, then one per window consumed
+            if (const size_t done = page - first_page; done % READ_AHEAD_PAGES == 0) {
+                const size_t ahead = page + 1 + (done == 0 ? 0 : READ_AHEAD_PAGES);
+                ReadAhead(ahead, std::min(end_page, page + 1 + 2 * READ_AHEAD_PAGES));
+            }
+
+            const Page data = Fetch(page);
+            if (!data) return false;
+
+            const size_t page_first = m_pages[page].first;
+            visit(*data, std::max(first, page_first) - page_first, std::min(last, page_first + data->size()) - page_first);
+        }
+
+        return true;
+    }
+
+    const BufferPool& Pool() const { return m_pool; }
+    std::uint64_t BytesRead() const { return m_bytes_read; }
+private:
+    struct PageEntry
+    {
+        std::uint64_t offset;       // Of the first record in the file
+        std::uint32_t bytes;
+        std::uint32_t count;
+        size_t first;               // Store position of the first task
+    };
+
+    Page Load(size_t page);
+    void ReadAhead(size_t first_page, size_t end_page) const;
+    bool ReadAt(std::uint64_t offset, size_t size, std::string &buffer);
+
+    int m_fd{-1};
+    bool m_u16_ids{false};
+    size_t m_task_count{0};
+    std::vector<PageEntry> m_pages;
+    BufferPool m_pool;
+    allocator_type m_allocator;
+    std::uint64_t m_bytes_read{0};
+    std::string m_buffer;                       // Raw bytes of the page being decoded
+    std::vector<std::string_view> m_tags;       // Scratch for `StoreFile::ReadRecord`
+};
+
+#endif //PAGEDSTORE_H
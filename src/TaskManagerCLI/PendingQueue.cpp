@@ -0,0 +1,111 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "PendingQueue.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+/* --------------------Ordering-------------------- */
+
+bool PendingQueue::Before(const Entry& a, const Entry& b)
+{
+    return std::tuple(b.priority, a.due, a.id) < std::tuple(a.priority, b.due, b.id);
+}
+
+/* --------------------Maintenance-------------------- */
+
+void PendingQueue::Add(const Task& task)
+{
+    if (task.status != Status::Pending) return;
+
+    const Entry entry{task.due == 0 ? std::numeric_limits<std::uint32_t>::max() : task.due, task.id, task.priority};
+    m_heap.push_back(entry);
+    m_slots[task.id] = m_heap.size() - 1;
+    SiftUp(m_heap.size() - 1);
+}
+
+void PendingQueue::Remove(const unsigned int id)
+{
+    const auto it = m_slots.find(id);
+    if (it == m_slots.end()) return;
+
+    const size_t slot = it->second;
+    m_slots.erase(it);
+
+    // The last entry fills the hole and moves whichever way restores the heap
+    const Entry last = m_heap.back();
+    m_heap.pop_back();
+    if (slot == m_heap.size()) return;
+
+    Place(slot, last);
+    SiftUp(slot);
+    SiftDown(m_slots[last.id]);
+}
+
+void PendingQueue::Clear()
+{
+    m_heap.clear();
+    m_slots.clear();
+}
+
+void PendingQueue::Place(const size_t slot, const Entry& entry)
+{
+    m_heap[slot] = entry;
+    m_slots[entry.id] = slot;
+}
+
+void PendingQueue::SiftUp(size_t slot)
+{
+    const Entry entry = m_heap[slot];
+    while (slot > 0) {
+        const size_t parent = (slot - 1) / 2;
+        if (!Before(entry, m_heap[parent])) break;
+        Place(slot, m_heap[parent]);
+        slot = parent;
+    }
+    Place(slot, entry);
+}
+
+void PendingQueue::SiftDown(size_t slot)
+{
+    const Entry entry = m_heap[slot];
+    while (true) {
+        size_t child = 2 * slot + 1;
+        if (child >= m_heap.size()) break;
+        if (child + 1 < m_heap.size() && Before(m_heap[child + 1], m_heap[child])) child++;
+        if (!Before(m_heap[child], entry)) break;
+        Place(slot, m_heap[child]);
+        slot = child;
+    }
+    Place(slot, entry);
+}
+
+/* --------------------Queries-------------------- */
+
+std::vector<unsigned int> PendingQueue::Top(const size_t count) const
+{
+    std::vector<unsigned int> ids;
+    if (m_heap.empty() || count == 0) return ids;
+
+    // The next entry is always the root of a subtree not taken yet, so only their roots are compared
+    const auto later = [this](const size_t a, const size_t b) { return Before(m_heap[b], m_heap[a]); };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(later)> frontier(later);
+    frontier.push(0);
+
+    ids.reserve(std::min(count, m_heap.size()));
+    while (ids.size() < count && !frontier.empty()) {
+        const size_t slot = frontier.top();
+        frontier.pop();
+        ids.push_back(m_heap[slot].id);
+
+        for (const size_t child : {2 * slot + 1, 2 * slot + 2}) {
+            if (child < m_heap.size()) frontier.push(child);
+        }
+    }
+
+    return ids;
+}
@@ -0,0 +1,56 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef PENDINGQUEUE_H
+#define PENDINGQUEUE_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#include "Tasks.h"
+
+/* PendingQueue
+ * ------------------------------------------------------------------------------
+ * The pending tasks in the order `next` hands them out: highest priority first,
+ * then the earliest due date (tasks without one last), then the lowest ID. An
+ * indexed binary heap maintained as tasks enter, change and leave the store:
+ * - Add / Remove -> O(log n), a completed task is never in the queue. The heap
+ *                   keeps a copy of the keys, so it never looks at the store.
+ * - Top          -> IDs of the first `count` tasks in order, O(count log count)
+ *                   without touching the rest of the heap.
+ * `m_slots` maps a task ID to its slot in the heap, so any task can be removed.
+ */
+class PendingQueue final
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    explicit PendingQueue(const allocator_type& allocator = {}) : m_heap(allocator), m_slots(allocator) {}
+
+    void Add(const Task& task);
+    void Remove(unsigned int id);
+    void Clear();
+
+    size_t size() const { return m_heap.size(); }
+    std::vector<unsigned int> Top(size_t count) const;
+private:
+    struct Entry
+    {
+        std::uint32_t due;      // Tasks without a due date rank after every date
+        unsigned int id;
+        Priority priority;
+    };
+
+    static bool Before(const Entry& a, const Entry& b);
+    void Place(size_t slot, const Entry& entry);
+    void SiftUp(size_t slot);
+    void SiftDown(size_t slot);
+
+    std::pmr::vector<Entry> m_heap;
+    std::pmr::unordered_map<unsigned int, size_t> m_slots;
+};
+
+#endif //PENDINGQUEUE_H
@@ -0,0 +1,100 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+/* Case-insensitive ASCII helpers usable at compile time */
+constexpr char ToLowerAscii(const char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr bool EqualsIgnoreCase(const std::string_view a, const std::string_view b)
+{
+    if (a.size() != b.size()) return false;
+
+    for (size_t i = 0; i < a.size(); i++) {
+        if (ToLowerAscii(a[i]) != ToLowerAscii(b[i])) return false;
+    }
+
+    return true;
+}
+
+/* PerfectHashMap
+ * ------------------------------------------------------------------------------
+ * Immutable string -> value map whose collision-free hash seed is searched for
+ * at compile time. A lookup hashes the key once (ignoring ASCII case), reads a
+ * single slot and does one comparison, with no allocation and no lowercased copy.
+ *
+ * FileManagerCLI builds on its own, so it carries an identical copy of this
+ * header (src/FileManagerCLI/src/Core/PerfectHash.h): change both together.
+ */
+template <typename Value, size_t KeyCount>
+class PerfectHashMap final
+{
+public:
+    struct Entry
+    {
+        std::string_view key;
+        Value value;
+    };
+
+    // At a load of 1/4 or less a collision-free seed turns up within a few hundred tries, at 1/2 it can take
+    // tens of thousands and run out of compile-time evaluation budget
+    static constexpr size_t TABLE_SIZE = std::bit_ceil(KeyCount * 4);
+
+    consteval explicit PerfectHashMap(const std::array<Entry, KeyCount> &entries)
+        : m_entries(entries)
+    {
+        while (!TryBuild()) m_seed++;
+    }
+
+    constexpr Value Find(const std::string_view key, const Value fallback) const
+    {
+        const std::uint8_t slot = m_slots[Hash(key, m_seed) & (TABLE_SIZE - 1)];
+
+        if (slot != 0 && EqualsIgnoreCase(m_entries[slot - 1].key, key))
+            return m_entries[slot - 1].value;
+
+        return fallback;
+    }
+private:
+    static constexpr std::uint32_t Hash(const std::string_view key, const std::uint32_t seed)
+    {
+        // FNV-1a over the lowercased bytes, with a final mix so that short keys spread well
+        std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (const char c : key) {
+            hash ^= static_cast<std::uint8_t>(ToLowerAscii(c));
+            hash *= 16777619u;
+        }
+        return hash ^ (hash >> 15);
+    }
+
+    constexpr bool TryBuild()
+    {
+        m_slots.fill(0);
+
+        for (size_t i = 0; i < KeyCount; i++) {
+            std::uint8_t& slot = m_slots[Hash(m_entries[i].key, m_seed) & (TABLE_SIZE - 1)];
+            if (slot != 0) return false;
+            slot = static_cast<std::uint8_t>(i + 1);
+        }
+
+        return true;
+    }
+
+    static_assert(KeyCount < 255, "Slots store 8-bit entry indexes");
+
+    std::array<Entry, KeyCount> m_entries{};
+    std::array<std::uint8_t, TABLE_SIZE> m_slots{};
+    std::uint32_t m_seed{0};
+};
+
+#endif //PERFECTHASH_H
@@ -0,0 +1,46 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "PlainText.h"
+
+/* --------------------Helpers-------------------- */
+
+static bool IsDecoration(const char32_t code_point)
+{
+    return (code_point >= 0x2600 && code_point <= 0x27BF)     // Miscellaneous symbols and dingbats
+        || (code_point >= 0x2B00 && code_point <= 0x2BFF)     // Miscellaneous symbols and arrows
+        || (code_point >= 0x1F000 && code_point <= 0x1FAFF)   // Pictographs and emoticons
+        || code_point == 0xFE0F || code_point == 0x200D;      // Variation selector and joiner
+}
+
+/* --------------------Messages-------------------- */
+
+std::string_view Undecorated(std::string_view message)
+{
+    bool dropped = false;
+
+    while (!message.empty()) {
+        const auto lead = static_cast<unsigned char>(message.front());
+        if (lead == ' ' && dropped) {
+            message.remove_prefix(1);
+            continue;
+        }
+
+        // Decode the UTF-8 sequence the message starts with, ASCII is never decoration
+        const size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+        if (length == 1 || message.size() < length) break;
+
+        char32_t code_point = lead & (0x7F >> length);
+        for (size_t i = 1; i < length; i++) {
+            code_point = (code_point << 6) | (static_cast<unsigned char>(message[i]) & 0x3F);
+        }
+
+        if (!IsDecoration(code_point)) break;
+
+        message.remove_prefix(length);
+        dropped = true;
+    }
+
+    return message;
+}
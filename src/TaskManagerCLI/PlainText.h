@@ -0,0 +1,23 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef PLAINTEXT_H
+#define PLAINTEXT_H
+
+#include <string_view>
+
+/* PlainText
+ * ------------------------------------------------------------------------------
+ * Emoji decoration of the messages, which scripted output (`tasks --batch`,
+ * `tasks -`) leaves out. Only message text goes through these, the tasks'
+ * descriptions and tags are always written as they are.
+ * - Icon        -> The icon of a message, or nothing in plain output.
+ * - Undecorated -> A message without the icon it starts with (pictographs,
+ *                  dingbats, variation selectors and the spaces after them).
+ */
+constexpr std::string_view Icon(const std::string_view icon, const bool plain) { return plain ? std::string_view{} : icon; }
+
+std::string_view Undecorated(std::string_view message);
+
+#endif //PLAINTEXT_H
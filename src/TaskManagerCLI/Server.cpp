@@ -0,0 +1,421 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "Server.h"
+#include "CommandLine.h"
+#include "CommandRegistry.h"
+
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include <nlohmann/json.hpp>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* --------------------Consts-------------------- */
+
+static constexpr std::uint64_t LISTEN_KEY = std::numeric_limits<std::uint64_t>::max();
+static constexpr std::uint64_t WAKE_KEY = LISTEN_KEY - 1;
+static constexpr std::uint64_t SIGNAL_KEY = LISTEN_KEY - 2;
+
+// A client that sends this much without a newline is dropped
+static constexpr size_t MAX_REQUEST_SIZE = 1 << 20;
+static constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+static constexpr int MAX_EVENTS = 64;
+
+/* --------------------Lifetime-------------------- */
+
+Server::Server(std::string socket_path, const size_t worker_count, TraceRecorder *recorder)
+    : m_socket_path(std::move(socket_path)), m_worker_count(std::max<size_t>(1, worker_count)), m_recorder(recorder),
+      m_readers(m_worker_count)
+{
+    m_writer.SetRecorder(recorder);
+    m_writer.SetReadMetrics([this] { return ReadMetrics(); });
+}
+
+Server::~Server()
+{
+    for (const auto &[id, connection] : m_connections) close(connection.fd);
+
+    for (const int fd : {m_listen_fd, m_epoll_fd, m_wake_fd, m_signal_fd}) {
+        if (fd != -1) close(fd);
+    }
+
+    if (m_listen_fd != -1) unlink(m_socket_path.c_str());
+}
+
+bool Server::Listen()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (m_socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "❌ Error: Socket path `" << m_socket_path << "` is too long.\n";
+        return false;
+    }
+    std::memcpy(address.sun_path, m_socket_path.c_str(), m_socket_path.size() + 1);
+
+    // A socket file nobody answers on is left over from a previous server and can be replaced
+    if (const int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0); probe != -1) {
+        const bool in_use = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe);
+
+        if (in_use) {
+            std::cerr << "❌ Error: Another server is already listening on `" << m_socket_path << "`.\n";
+            return false;
+        }
+        unlink(m_socket_path.c_str());
+    }
+
+    m_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listen_fd == -1
+        || bind(m_listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1
+        || listen(m_listen_fd, SOMAXCONN) == -1) {
+        std::cerr << "❌ Error: Unable to listen on `" << m_socket_path << "`: " << std::strerror(errno) << "\n";
+        if (m_listen_fd != -1) close(m_listen_fd);
+        m_listen_fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+int Server::Run()
+{
+    // Blocked before any worker starts, so the signals are only ever seen through the signalfd
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    if (!Listen()) return 1;
+
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    if (m_epoll_fd == -1 || m_wake_fd == -1 || m_signal_fd == -1) {
+        std::cerr << "❌ Error: Unable to set up the event loop: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    // Loads the store and publishes the first snapshot, before any reader can ask for one
+    m_writer.PublishSnapshots();
+    std::cerr << m_writer_output.str();
+    m_writer_output.str("");
+
+    Watch(m_listen_fd, EPOLLIN, LISTEN_KEY);
+    Watch(m_wake_fd, EPOLLIN, WAKE_KEY);
+    Watch(m_signal_fd, EPOLLIN, SIGNAL_KEY);
+
+    std::cout << "🛰️  Serving tasks on `" << m_socket_path << "` with " << m_worker_count << " worker(s), stop with Ctrl+C\n"
+              << std::flush;
+
+    for (size_t i = 0; i < m_worker_count; i++) m_workers.emplace_back(&Server::WorkerLoop, this, std::ref(m_readers[i]));
+
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+
+    while (running) {
+        const int count = epoll_wait(m_epoll_fd, events, MAX_EVENTS, -1);
+        if (count == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const std::uint64_t key = events[i].data.u64;
+
+            if (key == LISTEN_KEY) { Accept(); continue; }
+            if (key == WAKE_KEY) { DrainCompletions(); continue; }
+            if (key == SIGNAL_KEY) { running = false; continue; }
+
+            auto it = m_connections.find(key);
+            if (it == m_connections.end()) continue;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                Close(key);
+                continue;
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                ReadFrom(key, it->second);
+                it = m_connections.find(key);
+                if (it == m_connections.end()) continue;
+            }
+
+            if (events[i].events & EPOLLOUT) FlushTo(key, it->second);
+        }
+    }
+
+    {
+        std::lock_guard lock(m_jobs_mutex);
+        m_stopping = true;
+    }
+    m_jobs_ready.notify_all();
+    for (auto &worker : m_workers) worker.join();
+
+    std::cout << "\n👋 Server on `" << m_socket_path << "` stopped.\n";
+    return 0;
+}
+
+/* --------------------Event Loop-------------------- */
+
+void Server::Watch(const int fd, const std::uint32_t events, const std::uint64_t key, const bool modify) const
+{
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = key;
+    epoll_ctl(m_epoll_fd, modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event);
+}
+
+void Server::Accept()
+{
+    while (true) {
+        const int fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) return;
+
+        const std::uint64_t id = m_next_connection_id++;
+        m_connections[id].fd = fd;
+        Watch(fd, EPOLLIN | EPOLLRDHUP, id);
+    }
+}
+
+void Server::ReadFrom(const std::uint64_t id, Connection& connection)
+{
+    char buffer[READ_CHUNK_SIZE];
+    bool peer_done = false;
+
+    while (true) {
+        const ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, static_cast<size_t>(received));
+            continue;
+        }
+        if (received == 0) peer_done = true;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) return Close(id);
+        break;
+    }
+
+    size_t start = 0;
+    for (size_t end; (end = connection.input.find('\n', start)) != std::string::npos; start = end + 1) {
+        size_t length = end - start;
+        if (length > 0 && connection.input[end - 1] == '\r') length--;
+        connection.pending.emplace_back(connection.input, start, length);
+    }
+    connection.input.erase(0, start);
+
+    if (connection.input.size() > MAX_REQUEST_SIZE) return Close(id);
+
+    if (peer_done) {
+        // The client will not send more, the requests it already sent are still answered
+        connection.read_closed = true;
+        Watch(connection.fd, connection.writable_armed ? static_cast<std::uint32_t>(EPOLLOUT) : 0u, id, true);
+    }
+
+    Dispatch(id, connection);
+}
+
+void Server::Dispatch(const std::uint64_t id, Connection& connection)
+{
+    if (!connection.busy && !connection.pending.empty()) {
+        connection.busy = true;
+
+        {
+            std::lock_guard lock(m_jobs_mutex);
+            m_jobs.push_back({id, std::move(connection.pending.front())});
+        }
+        connection.pending.pop_front();
+        m_jobs_ready.notify_one();
+        return;
+    }
+
+    if (!connection.busy && connection.pending.empty() && connection.output.empty()
+        && (connection.read_closed || connection.close_after_flush)) {
+        Close(id);
+    }
+}
+
+void Server::FlushTo(const std::uint64_t id, Connection& connection)
+{
+    while (connection.output_offset < connection.output.size()) {
+        const ssize_t sent = send(connection.fd, connection.output.data() + connection.output_offset,
+                                  connection.output.size() - connection.output_offset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.output_offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!connection.writable_armed) {
+                connection.writable_armed = true;
+                Watch(connection.fd, (connection.read_closed ? 0 : EPOLLIN | EPOLLRDHUP) | EPOLLOUT, id, true);
+            }
+            return;
+        }
+        return Close(id);
+    }
+
+    connection.output.clear();
+    connection.output_offset = 0;
+
+    if (connection.writable_armed) {
+        connection.writable_armed = false;
+        Watch(connection.fd, connection.read_closed ? 0 : EPOLLIN | EPOLLRDHUP, id, true);
+    }
+
+    Dispatch(id, connection);
+}
+
+void Server::DrainCompletions()
+{
+    std::uint64_t wakeups;
+    while (read(m_wake_fd, &wakeups, sizeof(wakeups)) > 0) {}
+
+    std::vector<Completion> completions;
+    {
+        std::lock_guard lock(m_completions_mutex);
+        completions.swap(m_completions);
+    }
+
+    for (auto &completion : completions) {
+        // The client may have gone away while its request was running
+        const auto it = m_connections.find(completion.connection_id);
+        if (it == m_connections.end()) continue;
+
+        Connection& connection = it->second;
+        connection.busy = false;
+        connection.output += completion.reply;
+
+        if (completion.exit) {
+            connection.close_after_flush = true;
+            connection.pending.clear();
+        }
+
+        FlushTo(completion.connection_id, connection);
+    }
+}
+
+void Server::Close(const std::uint64_t id)
+{
+    const auto it = m_connections.find(id);
+    if (it == m_connections.end()) return;
+
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+
+    // A request still running for this client finishes, its reply is then dropped
+    m_connections.erase(it);
+}
+
+/* --------------------Workers-------------------- */
+
+void Server::WorkerLoop(Reader& reader)
+{
+    CommandLine line;
+    std::ostringstream output;
+    Manager manager(output, output);
+    manager.SetRecorder(m_recorder);
+
+    {
+        std::lock_guard lock(reader.mutex);
+        reader.manager = &manager;
+    }
+
+    // The manager goes away with this thread, `stats` must not find it afterwards
+    struct Unregister
+    {
+        Reader& reader;
+        ~Unregister()
+        {
+            std::lock_guard lock(reader.mutex);
+            reader.manager = nullptr;
+        }
+    } unregister{reader};
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(m_jobs_mutex);
+            m_jobs_ready.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        bool exit = false;
+        std::string reply = Execute(job.request, line, reader, output, exit);
+
+        {
+            std::lock_guard lock(m_completions_mutex);
+            m_completions.push_back({job.connection_id, std::move(reply), exit});
+        }
+
+        constexpr std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = write(m_wake_fd, &one, sizeof(one));
+    }
+}
+
+std::string Server::Execute(const std::string& request, CommandLine& line, Reader& reader, std::ostringstream& output, bool& exit)
+{
+    std::string command = request;
+    const bool json = !request.empty() && request.front() == '{';
+
+    if (json) {
+        const auto document = nlohmann::json::parse(request, nullptr, false);
+        if (document.is_discarded() || !document.is_object() || !document.contains("command") || !document["command"].is_string()) {
+            const std::string body = nlohmann::json{{"error", R"(expected {"command": "<command line>"})"}}.dump();
+            return std::to_string(body.size()) + "\n" + body;
+        }
+        command = document["command"].get<std::string>();
+    }
+
+    bool empty_quotes;
+    GetInput(command, line, empty_quotes);
+
+    if (line.tokens.empty()) {
+        // An empty line gets an empty reply
+    } else if (empty_quotes) {
+        PrintEmptyQuotesError(output);
+    } else if (Manager::IsReadOnly(LookupCommand(line.tokens[0]))) {
+        // The snapshot stays alive for as long as this command reads it, whatever the writer does meanwhile
+        const std::shared_ptr<const TaskSnapshot> snapshot = m_writer.Snapshot();
+        std::lock_guard lock(reader.mutex);
+        exit = reader.manager->HandleReadCommand(*snapshot, line.tokens.size(), line.tokens) == RunStatus::Exit;
+    } else {
+        std::lock_guard lock(m_writer_mutex);
+        exit = m_writer.HandleCommand(line.tokens.size(), line.tokens) == RunStatus::Exit;
+
+        output << m_writer_output.str();
+        m_writer_output.str("");
+    }
+
+    std::string body = output.str();
+    output.str("");
+    if (json) {
+        body = nlohmann::json{{"command", command}, {"output", body}, {"exit", exit}}
+            .dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
+    return std::to_string(body.size()) + "\n" + body;
+}
+
+CommandMetrics Server::ReadMetrics()
+{
+    // Runs on the writer (under `m_writer_mutex`), readers never take that mutex, so this cannot deadlock
+    CommandMetrics metrics;
+    for (auto &reader : m_readers) {
+        std::lock_guard lock(reader.mutex);
+        if (reader.manager) metrics.Merge(reader.manager->Metrics());
+    }
+
+    return metrics;
+}
@@ -0,0 +1,130 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CommandLine.h"
+#include "Manager.h"
+
+/* Server
+ * ------------------------------------------------------------------------------
+ * `tasks --serve PATH`: keeps one `Manager` (and so one store and one undo
+ * history) resident and serves any number of clients over a Unix socket.
+ *
+ * Protocol, one request per line:
+ * - A plain line is a command in the usual grammar (`list --limit 10`), the
+ *   reply body is the rendered output.
+ * - A JSON object line (`{"command": "list --limit 10"}`) gets a JSON reply:
+ *   `{"command": ..., "output": ..., "exit": false}`.
+ * Every reply is framed as `<body length>\n<body>`. Requests of a connection are
+ * answered in order; `exit` closes the connection, not the server.
+ *
+ * One thread runs the epoll loop and does all socket I/O; a pool of workers
+ * tokenizes requests, runs them and formats the replies:
+ * - Commands that change the tasks run one at a time on the writer manager
+ *   (`m_writer_mutex`), which publishes a new snapshot before replying.
+ * - Read-only commands run on the worker's own reader manager against the
+ *   latest snapshot. They never wait for the writer, and the writer never waits
+ *   for them: a long `list` or `export` keeps the snapshot it started with alive.
+ *   Only `stats` looks at the readers, it waits for each one's current command
+ *   to add the reader's metrics to the writer's.
+ */
+class Server final
+{
+public:
+    Server(std::string socket_path, size_t worker_count, TraceRecorder *recorder = nullptr);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /* Serves until SIGINT / SIGTERM, returns the process exit code */
+    int Run();
+private:
+    struct Connection
+    {
+        int fd{-1};
+        std::string input;
+        std::string output;
+        size_t output_offset{0};
+        std::deque<std::string> pending;
+        bool busy{false};               // A request of this connection is with a worker
+        bool read_closed{false};        // The client shut down its side, answer what it sent then close
+        bool close_after_flush{false};  // The client sent `exit`
+        bool writable_armed{false};     // Waiting for EPOLLOUT to finish a reply
+    };
+
+    struct Job
+    {
+        std::uint64_t connection_id;
+        std::string request;
+    };
+
+    struct Completion
+    {
+        std::uint64_t connection_id;
+        std::string reply;
+        bool exit;
+    };
+
+    // A worker's reader manager, locked while it runs a command so `stats` reads its metrics in between
+    struct Reader
+    {
+        std::mutex mutex;
+        Manager *manager{nullptr};
+    };
+
+    /* Event loop (loop thread only) */
+    bool Listen();
+    void Accept();
+    void ReadFrom(std::uint64_t id, Connection& connection);
+    void FlushTo(std::uint64_t id, Connection& connection);
+    void Dispatch(std::uint64_t id, Connection& connection);
+    void DrainCompletions();
+    void Close(std::uint64_t id);
+    void Watch(int fd, std::uint32_t events, std::uint64_t key, bool modify = false) const;
+
+    /* Workers */
+    void WorkerLoop(Reader& reader);
+    std::string Execute(const std::string& request, CommandLine& line, Reader& reader, std::ostringstream& output, bool& exit);
+    CommandMetrics ReadMetrics();
+
+    std::ostringstream m_writer_output;
+    Manager m_writer{m_writer_output, m_writer_output};
+    std::mutex m_writer_mutex;
+    std::string m_socket_path;
+    size_t m_worker_count;
+    TraceRecorder *m_recorder;
+
+    int m_listen_fd{-1};
+    int m_epoll_fd{-1};
+    int m_wake_fd{-1};
+    int m_signal_fd{-1};
+
+    std::unordered_map<std::uint64_t, Connection> m_connections;
+    std::uint64_t m_next_connection_id{0};
+
+    std::vector<std::thread> m_workers;
+    std::vector<Reader> m_readers;
+    std::mutex m_jobs_mutex;
+    std::condition_variable m_jobs_ready;
+    std::deque<Job> m_jobs;
+    bool m_stopping{false};
+
+    std::mutex m_completions_mutex;
+    std::vector<Completion> m_completions;
+};
+
+#endif //SERVER_H
@@ -0,0 +1,458 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "StoreFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+/* --------------------Consts-------------------- */
+
+// Layout (host byte order):
+//   magic | u32 task count | u32 next id
+//   per task: u32 id | u8 priority | u8 status | u32 len + description | u8 len + due | u16 tag count | (u16 len + tag)*
+// Stores written before IDs were widened (`TASKS001`) hold the IDs as u16 and are still read.
+static constexpr std::string_view STORE_MAGIC = "TASKS002";
+static constexpr std::string_view STORE_MAGIC_U16_IDS = "TASKS001";
+
+/* --------------------Encoding Helpers-------------------- */
+
+template <typename T>
+static void Write(std::string &buffer, const T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+template <typename Length>
+static void WriteText(std::string &buffer, const std::string_view text)
+{
+    Write(buffer, static_cast<Length>(text.size()));
+    buffer.append(text);
+}
+
+class StoreReader final
+{
+public:
+    explicit StoreReader(const std::string_view buffer) : m_data(buffer) {}
+
+    template <typename T>
+    bool Read(T &value)
+    {
+        if (m_data.size() - m_position < sizeof(T)) return false;
+
+        std::memcpy(&value, m_data.data() + m_position, sizeof(T));
+        m_position += sizeof(T);
+        return true;
+    }
+
+    template <typename Length>
+    bool ReadText(std::string_view &text)
+    {
+        Length length;
+        if (!Read(length) || m_data.size() - m_position < length) return false;
+
+        text = m_data.substr(m_position, length);
+        m_position += length;
+        return true;
+    }
+
+    bool ReadMagic(bool &u16_ids)
+    {
+        const std::string_view magic = m_data.substr(0, STORE_MAGIC.size());
+        if (magic != STORE_MAGIC && magic != STORE_MAGIC_U16_IDS) return false;
+
+        u16_ids = magic == STORE_MAGIC_U16_IDS;
+        m_position = STORE_MAGIC.size();
+        return true;
+    }
+
+    bool ReadId(unsigned int &id, const bool u16_id)
+    {
+        if (!u16_id) return Read(id);
+
+        std::uint16_t narrow;
+        if (!Read(narrow)) return false;
+
+        id = narrow;
+        return true;
+    }
+
+    void Skip(const size_t count) { m_position = std::min(m_data.size(), m_position + count); }
+    bool AtEnd() const { return m_position == m_data.size(); }
+    size_t Position() const { return m_position; }
+private:
+    std::string_view m_data;
+    size_t m_position{0};
+};
+
+/* --------------------Records-------------------- */
+
+static void WriteTask(std::string &buffer, const TaskTable &tasks, const Task &task)
+{
+    Write(buffer, static_cast<std::uint32_t>(task.id));
+    Write(buffer, static_cast<std::uint8_t>(task.priority));
+    Write(buffer, static_cast<std::uint8_t>(task.status));
+    WriteText<std::uint32_t>(buffer, tasks.Description(task));
+    WriteText<std::uint8_t>(buffer, FormatDate(task.due));
+    Write(buffer, task.tag_count);
+
+    for (const auto tag : tasks.Tags(task)) {
+        WriteText<std::uint16_t>(buffer, tag);
+    }
+}
+
+// `tags` is scratch space, kept by the caller so its capacity carries over from one task to the next
+static bool ReadTask(StoreReader &reader, const bool u16_ids, TaskTable &tasks, std::vector<std::string_view> &tags)
+{
+    Task task;
+    std::uint8_t priority, status;
+    std::uint16_t tag_count;
+    std::string_view description, due;
+
+    if (!reader.ReadId(task.id, u16_ids) || !reader.Read(priority) || !reader.Read(status)
+        || !reader.ReadText<std::uint32_t>(description) || !reader.ReadText<std::uint8_t>(due)
+        || !reader.Read(tag_count)) {
+        return false;
+    }
+
+    if (priority >= static_cast<std::uint8_t>(Priority::Invalid) || status >= static_cast<std::uint8_t>(Status::None))
+        return false;
+
+    task.priority = static_cast<Priority>(priority);
+    task.status = static_cast<Status>(status);
+    task.due = PackDate(due);
+
+    tags.resize(tag_count);
+    for (auto &tag : tags) {
+        if (!reader.ReadText<std::uint16_t>(tag)) return false;
+    }
+
+    tasks.SetDescription(task, description);
+    tasks.SetTags(task, tags);
+    tasks.push_back(task);
+    return true;
+}
+
+/* --------------------Load / Save-------------------- */
+
+bool StoreFile::Load(const std::string &file_path, TaskTable &tasks, unsigned int &next_id)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) return !std::filesystem::exists(file_path);
+
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    StoreReader reader(buffer);
+
+    std::uint32_t count;
+    bool u16_ids;
+    if (!reader.ReadMagic(u16_ids) || !reader.Read(count) || !reader.ReadId(next_id, u16_ids)) return false;
+
+    // Every task takes at least 13 bytes, which keeps a damaged count from allocating the world
+    if (count > buffer.size() / 13) return false;
+
+    TaskTable loaded(tasks.get_allocator());
+    loaded.reserve(count);
+    std::vector<std::string_view> tags;
+
+    for (std::uint32_t i = 0; i < count; i++) {
+        if (!ReadTask(reader, u16_ids, loaded, tags)) return false;
+    }
+
+    if (!reader.AtEnd()) return false;
+
+    tasks = std::move(loaded);
+    return true;
+}
+
+bool StoreFile::Save(const std::string &file_path, const TaskTable &tasks, const unsigned int next_id)
+{
+    std::string buffer(STORE_MAGIC);
+    Write(buffer, static_cast<std::uint32_t>(tasks.size()));
+    Write(buffer, static_cast<std::uint32_t>(next_id));
+
+    for (const auto &task : tasks) WriteTask(buffer, tasks, task);
+
+    const std::string temp_path = file_path + ".tmp";
+
+    const int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) return false;
+
+    bool written = true;
+    for (size_t offset = 0; written && offset < buffer.size();) {
+        const ssize_t count = write(fd, buffer.data() + offset, buffer.size() - offset);
+        if (count > 0) offset += static_cast<size_t>(count);
+        else written = count == -1 && errno == EINTR;
+    }
+
+    // The data has to be on disk before the rename makes it the store
+    written = written && fsync(fd) == 0;
+    if (close(fd) != 0 || !written) return false;
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, file_path, error);
+    if (error) return false;
+
+    // And the rename itself is only durable once the directory is
+    const std::filesystem::path directory = std::filesystem::absolute(file_path).parent_path();
+    if (const int directory_fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); directory_fd != -1) {
+        fsync(directory_fd);
+        close(directory_fd);
+    }
+
+    return true;
+}
+
+/* --------------------Paged Reads-------------------- */
+
+bool StoreFile::ReadHeader(const std::string_view bytes, StoreHeader &header)
+{
+    StoreReader reader(bytes);
+    if (!reader.ReadMagic(header.u16_ids) || !reader.Read(header.count) || !reader.ReadId(header.next_id, header.u16_ids))
+        return false;
+
+    header.size = reader.Position();
+    return true;
+}
+
+size_t StoreFile::ReadRecord(const std::string_view bytes, const bool u16_ids, TaskTable &tasks, std::vector<std::string_view> &tags)
+{
+    StoreReader reader(bytes);
+    return ReadTask(reader, u16_ids, tasks, tags) ? reader.Position() : 0;
+}
+
+/* --------------------Archive-------------------- */
+
+// Chunk layout (host byte order), every append adding one gzip member of whole chunks:
+//   magic | u32 task count | u32 body size | body (the tasks, laid out like in the store)
+static constexpr std::string_view ARCHIVE_MAGIC = "TARCH001";
+static constexpr size_t ARCHIVE_HEADER_SIZE = ARCHIVE_MAGIC.size() + 2 * sizeof(std::uint32_t);
+
+// Chunks are what a scan holds in memory at a time
+static constexpr size_t ARCHIVE_CHUNK_TASKS = 10'000;
+
+// The smallest task a chunk body can hold: u32 id, priority, status, u32 description length, u8 due length and
+// u16 tag count. A count that cannot fit in the body is damage, and is refused before it sizes an allocation.
+static constexpr size_t ARCHIVE_MIN_TASK_SIZE = sizeof(std::uint32_t) + 2 + sizeof(std::uint32_t) + 1 + sizeof(std::uint16_t);
+
+// Where the archive last ended on a whole member, kept next to it so that an append only has to check what came
+// after that (a member cut short, or one whose append did not get to record it). It is only a hint: missing,
+// past the end of the archive or not on a member, the check starts from the top of the archive again.
+static std::string ArchiveEndPath(const std::string &file_path) { return file_path + ".end"; }
+
+static off_t ReadArchiveEnd(const std::string &file_path, const off_t archive_size)
+{
+    std::ifstream file(ArchiveEndPath(file_path), std::ios::binary);
+    std::uint64_t end = 0;
+    if (!file.read(reinterpret_cast<char*>(&end), sizeof(end)) || end > static_cast<std::uint64_t>(archive_size)) return 0;
+    return static_cast<off_t>(end);
+}
+
+static void WriteArchiveEnd(const std::string &file_path, const off_t end)
+{
+    // Not synced: a lost or torn record is one the next append does not trust
+    const auto value = static_cast<std::uint64_t>(end);
+    std::ofstream file(ArchiveEndPath(file_path), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Inflates the archive from `offset` on, handing the output to `visit` as it goes. `end` is left at the end of
+// the last whole member; past it there may only be a member cut short, anything else is a damaged archive.
+template <typename Visit>
+static bool InflateArchive(const int fd, off_t offset, off_t &end, Visit &&visit)
+{
+    z_stream stream{};
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) return false;
+
+    std::string input(64 * 1024, '\0'), output(64 * 1024, '\0');
+    end = offset;
+    bool valid = true;
+
+    while (valid) {
+        if (stream.avail_in == 0) {
+            ssize_t count;
+            do count = pread(fd, input.data(), input.size(), offset);
+            while (count == -1 && errno == EINTR);
+
+            if (count <= 0) {
+                valid = count == 0;
+                break;
+            }
+
+            offset += count;
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = static_cast<uInt>(count);
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        const int status = inflate(&stream, Z_NO_FLUSH);
+        visit(std::string_view(output.data(), output.size() - stream.avail_out));
+
+        if (status == Z_STREAM_END) {
+            end = offset - static_cast<off_t>(stream.avail_in);
+            valid = inflateReset(&stream) == Z_OK;
+        } else {
+            valid = status == Z_OK;
+        }
+    }
+
+    inflateEnd(&stream);
+    return valid;
+}
+
+// The whole, valid chunks at the start of `bytes` (what could be inflated of a member cut short)
+static std::string_view WholeChunks(const std::string_view bytes)
+{
+    std::vector<std::string_view> tags;
+    TaskTable chunk;
+    size_t whole = 0;
+
+    while (bytes.substr(whole).starts_with(ARCHIVE_MAGIC)) {
+        StoreReader header_reader(bytes.substr(whole));
+        std::uint32_t count, size;
+        header_reader.Skip(ARCHIVE_MAGIC.size());
+        if (!header_reader.Read(count) || !header_reader.Read(size)) break;
+
+        const size_t body_offset = whole + header_reader.Position();
+        if (bytes.size() - body_offset < size) break;
+
+        chunk.clear();
+        StoreReader reader(bytes.substr(body_offset, size));
+        bool valid = true;
+        for (std::uint32_t i = 0; valid && i < count; i++) valid = ReadTask(reader, false, chunk, tags);
+        if (!valid || !reader.AtEnd()) break;
+
+        whole = body_offset + size;
+    }
+
+    return bytes.substr(0, whole);
+}
+
+bool StoreFile::AppendArchive(const std::string &file_path, const TaskTable &tasks, const std::vector<size_t> &positions)
+{
+    const int fd = open(file_path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1) return false;
+
+    // A member cut short would swallow the one appended behind it. It is cut off, and the chunks that can
+    // still be read from it go into the new member ahead of the tasks being archived. Only the members past
+    // the recorded end are inflated to find it, the whole archive just when that record cannot be trusted.
+    off_t end = 0;
+    std::string torn;
+    struct stat status{};
+    bool valid = fstat(fd, &status) == 0;
+    if (valid) {
+        const off_t recorded = ReadArchiveEnd(file_path, status.st_size);
+        valid = InflateArchive(fd, recorded, end, [](std::string_view) {});
+        if (!valid && recorded != 0) valid = InflateArchive(fd, 0, end, [](std::string_view) {});
+    }
+
+    if (valid && end < status.st_size) {
+        valid = InflateArchive(fd, end, end, [&torn](const std::string_view output) { torn.append(output); });
+        torn.resize(WholeChunks(torn).size());
+    }
+
+    if (!valid || ftruncate(fd, end) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // zlib gets a duplicate, closing the member closes it, and `fd` stays open for the fsync
+    const int gz_fd = dup(fd);
+    gzFile file = gz_fd == -1 ? nullptr : gzdopen(gz_fd, "ab");
+    if (file == nullptr) {
+        if (gz_fd != -1) close(gz_fd);
+        close(fd);
+        return false;
+    }
+
+    bool written = torn.empty() || gzwrite(file, torn.data(), static_cast<unsigned>(torn.size())) == static_cast<int>(torn.size());
+    std::string chunk;
+    for (size_t first = 0; written && first < positions.size(); first += ARCHIVE_CHUNK_TASKS) {
+        const size_t last = std::min(positions.size(), first + ARCHIVE_CHUNK_TASKS);
+
+        std::string body;
+        for (size_t i = first; i < last; i++) WriteTask(body, tasks, tasks[positions[i]]);
+
+        chunk.assign(ARCHIVE_MAGIC);
+        Write(chunk, static_cast<std::uint32_t>(last - first));
+        Write(chunk, static_cast<std::uint32_t>(body.size()));
+        chunk.append(body);
+
+        written = gzwrite(file, chunk.data(), static_cast<unsigned>(chunk.size())) == static_cast<int>(chunk.size());
+    }
+
+    // The archive has to be on disk before the tasks leave the store. A failed append is cut off again
+    // (the next append trims it if that fails too), so the archive keeps ending on a whole member.
+    written = gzclose(file) == Z_OK && written;
+    if (written) written = fsync(fd) == 0;
+    else if (ftruncate(fd, end) == 0) fsync(fd);
+
+    if (written && fstat(fd, &status) == 0) WriteArchiveEnd(file_path, status.st_size);
+    return close(fd) == 0 && written;
+}
+
+bool StoreFile::ScanArchive(const std::string &file_path, const std::function<void(const TaskTable &chunk)> &visit)
+{
+    gzFile file = gzopen(file_path.c_str(), "rb");
+    if (file == nullptr) return !std::filesystem::exists(file_path);
+
+    // Bytes read, or -1 on an error
+    const auto read = [&file](std::string &buffer, const size_t size) {
+        buffer.resize(size);
+        return size == 0 ? 0 : gzread(file, buffer.data(), static_cast<unsigned>(size));
+    };
+
+    bool valid = true;
+    std::string header, body;
+    std::vector<std::string_view> tags;
+    TaskTable chunk;
+
+    // Appends are whole members, so the archive may only end between two chunks
+    while (valid) {
+        const int header_read = read(header, ARCHIVE_HEADER_SIZE);
+        if (header_read == 0) break;
+        if (header_read != static_cast<int>(ARCHIVE_HEADER_SIZE) || !header.starts_with(ARCHIVE_MAGIC)) {
+            valid = false;
+            break;
+        }
+
+        StoreReader header_reader(header);
+        std::uint32_t count, size;
+        header_reader.Skip(ARCHIVE_MAGIC.size());
+        if (!header_reader.Read(count) || !header_reader.Read(size) || count > size / ARCHIVE_MIN_TASK_SIZE
+            || read(body, size) != static_cast<int>(size)) {
+            valid = false;
+            break;
+        }
+
+        chunk.clear();
+        chunk.reserve(count);
+        StoreReader reader(body);
+        for (std::uint32_t i = 0; valid && i < count; i++) valid = ReadTask(reader, false, chunk, tags);
+
+        valid = valid && reader.AtEnd();
+        if (valid) visit(chunk);
+    }
+
+    // A member cut short reads as an early end, zlib only records it as an error
+    int error = Z_OK;
+    if (valid) gzerror(file, &error);
+    valid = valid && error == Z_OK;
+
+    gzclose(file);
+    return valid;
+}
@@ -0,0 +1,69 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef STOREFILE_H
+#define STOREFILE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TaskTable.h"
+
+/* StoreFile
+ * ------------------------------------------------------------------------------
+ * Compact binary snapshot of the task store, so a fresh process can pick the
+ * tasks up with a single read and no text parsing.
+ * - Load -> Reads the snapshot. A missing file is an empty store, a damaged
+ *           one makes `Load` return false.
+ * - Save -> Writes the snapshot to a temporary file, fsyncs it and renames it
+ *           over the old one, so a crash never leaves a half-written store
+ *           behind. The fsync makes it slow, `StoreWriter` runs it off the command thread.
+ *
+ * Readers that page through the store instead of loading it (see `PagedStore`)
+ * go one record at a time:
+ * - ReadHeader -> Parses the header at the start of the file.
+ * - ReadRecord -> Appends the task whose record starts `bytes` to `tasks` and
+ *                 returns the size of the record, or 0 if `bytes` does not hold a
+ *                 whole valid one (nothing is appended then).
+ *
+ * The cold archive next to the store is append-only and gzip-compressed:
+ * - AppendArchive -> Appends the tasks at the given positions as one gzip member
+ *                    of chunks, and fsyncs it. A member an earlier append left cut
+ *                    short is trimmed first (only what follows the end recorded
+ *                    in `<archive>.end` is inflated to find it), a failed append
+ *                    is cut off again. False on a damaged archive.
+ * - ScanArchive   -> Streams the archive one chunk (up to 10k tasks) at a time.
+ *                    A missing archive is empty, a damaged or truncated one makes
+ *                    it return false.
+ *
+ * A tag is stored behind a 16-bit length, so no tag may be longer than
+ * `MAX_TAG_BYTES`: the commands that take tags refuse longer ones.
+ */
+struct StoreHeader
+{
+    std::uint32_t count{0};
+    unsigned int next_id{1};
+    bool u16_ids{false};
+    size_t size{0};         // Bytes before the first record
+};
+
+class StoreFile final
+{
+public:
+    static constexpr size_t MAX_TAG_BYTES = UINT16_MAX;
+
+    static bool Load(const std::string &file_path, TaskTable &tasks, unsigned int &next_id);
+    static bool Save(const std::string &file_path, const TaskTable &tasks, unsigned int next_id);
+
+    static bool ReadHeader(std::string_view bytes, StoreHeader &header);
+    static size_t ReadRecord(std::string_view bytes, bool u16_ids, TaskTable &tasks, std::vector<std::string_view> &tags);
+
+    static bool AppendArchive(const std::string &file_path, const TaskTable &tasks, const std::vector<size_t> &positions);
+    static bool ScanArchive(const std::string &file_path, const std::function<void(const TaskTable &chunk)> &visit);
+};
+
+#endif //STOREFILE_H
@@ -0,0 +1,132 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "StoreWriter.h"
+#include "StoreFile.h"
+
+#include <algorithm>
+#include <filesystem>
+
+/* --------------------Lifetime-------------------- */
+
+StoreWriter::StoreWriter(std::string file_path) : m_file_path(std::move(file_path)), m_thread(&StoreWriter::Run, this) {}
+
+StoreWriter::~StoreWriter()
+{
+    m_stopping.store(true);
+    m_signal.release();
+    m_thread.join();
+}
+
+/* --------------------Command Thread-------------------- */
+
+std::uint64_t StoreWriter::Submit(std::shared_ptr<const TaskTable> tasks, const unsigned int next_id)
+{
+    const std::uint64_t sequence = m_next_sequence.fetch_add(1) + 1;
+
+    auto *record = new Record{sequence, std::move(tasks), next_id, m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed)) {}
+
+    const size_t depth = m_depth.fetch_add(1) + 1;
+    for (size_t max = m_max_depth.load(); depth > max && !m_max_depth.compare_exchange_weak(max, depth);) {}
+
+    // The first record of a group starts the commit window, a full group is committed right away
+    if (record->next == nullptr || depth == GROUP_SIZE) m_signal.release();
+
+    return sequence;
+}
+
+bool StoreWriter::WaitDurable(const std::uint64_t sequence)
+{
+    m_sync_waiters.fetch_add(1);
+    m_signal.release();
+
+    for (auto completed = m_completed.load(); completed < sequence; completed = m_completed.load()) {
+        m_completed.wait(completed);
+    }
+
+    m_sync_waiters.fetch_sub(1);
+
+    // A later commit that succeeded also holds this record's changes
+    return m_durable.load() >= sequence;
+}
+
+StoreWriterStats StoreWriter::Stats() const
+{
+    StoreWriterStats stats;
+    {
+        std::lock_guard lock(m_stats_mutex);
+        stats = m_stats;
+    }
+
+    stats.submitted = m_next_sequence.load();
+    stats.queue_depth = m_depth.load();
+    stats.max_queue_depth = m_max_depth.load();
+    return stats;
+}
+
+/* --------------------Persistence Thread-------------------- */
+
+void StoreWriter::Run()
+{
+    while (true) {
+        if (m_head.load(std::memory_order_acquire) == nullptr) {
+            if (m_stopping.load()) return;
+
+            m_signal.acquire();
+            continue;
+        }
+
+        // Lets later records join the group until it is due, a wake-up without a trigger keeps waiting
+        const auto deadline = std::chrono::steady_clock::now() + COMMIT_INTERVAL;
+        while (m_depth.load() < GROUP_SIZE && m_sync_waiters.load() == 0 && !m_stopping.load()
+               && m_signal.try_acquire_until(deadline)) {}
+
+        Commit(m_head.exchange(nullptr, std::memory_order_acq_rel));
+    }
+}
+
+void StoreWriter::Commit(Record *records)
+{
+    const Record *newest = records;
+    size_t count = 0;
+
+    for (const Record *record = records; record != nullptr; record = record->next) {
+        if (record->sequence > newest->sequence) newest = record;
+        count++;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool saved = StoreFile::Save(m_file_path, *newest->tasks, newest->next_id);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::error_code ec;
+    const std::uintmax_t size = saved ? std::filesystem::file_size(m_file_path, ec) : 0;
+
+    const std::uint64_t sequence = newest->sequence;
+
+    while (records != nullptr) {
+        Record *next = records->next;
+        delete records;
+        records = next;
+    }
+
+    m_depth.fetch_sub(count);
+
+    {
+        std::lock_guard lock(m_stats_mutex);
+        m_stats.commits++;
+        if (saved) m_stats.committed += count;
+        if (!ec) m_stats.bytes_written += size;
+        m_stats.last_commit_ms = elapsed_ms;
+        m_stats.max_commit_ms = std::max(m_stats.max_commit_ms, elapsed_ms);
+        m_stats.total_commit_ms += elapsed_ms;
+    }
+
+    if (saved) m_durable.store(sequence);
+    else m_failed.store(true);
+
+    m_completed.store(sequence);
+    m_completed.notify_all();
+}
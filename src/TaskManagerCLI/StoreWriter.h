@@ -0,0 +1,105 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef STOREWRITER_H
+#define STOREWRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TaskTable.h"
+
+// Counters of the persistence thread, see `StoreWriter::Stats`
+struct StoreWriterStats
+{
+    std::uint64_t submitted{};      // Records queued since the writer started
+    std::uint64_t committed{};      // Records made durable
+    std::uint64_t commits{};        // Group commits (file writes + fsync) done
+    std::uint64_t bytes_written{};  // Size of the stores written by the commits
+    size_t queue_depth{};           // Records waiting for the next commit
+    size_t max_queue_depth{};
+    double last_commit_ms{};        // Write + fsync time of the last commit
+    double max_commit_ms{};
+    double total_commit_ms{};
+};
+
+/* StoreWriter
+ * ------------------------------------------------------------------------------
+ * Background persistence stage of the task store. The command thread hands over
+ * a record of the store after every change and carries on; the persistence
+ * thread turns whatever has piled up into a single group commit (one write and
+ * one fsync of the newest state). A record shares an immutable table (the undo
+ * history's newest entry) instead of copying the store, and the file image is
+ * only built by the persistence thread.
+ * - Submit      -> Queues a record without blocking, returns its sequence number.
+ * - WaitDurable -> Blocks until the record with that sequence number is on disk,
+ *                  false if the commit failed.
+ * - TakeFailure -> Whether a commit failed since the last call.
+ * - Stats       -> Queue depth and commit latency counters.
+ *
+ * Records go through a lock-free stack that the persistence thread empties in one
+ * exchange; a commit writes the newest record of the group, which holds every
+ * change of the older ones. Sequence numbers are acknowledged in order, so a
+ * store has one submitting thread (the manager that owns it).
+ *
+ * A group is committed once `COMMIT_INTERVAL` has passed since its first record,
+ * once `GROUP_SIZE` records are queued, or as soon as a caller waits for
+ * durability, whichever comes first. Destroying the writer commits everything
+ * still queued.
+ */
+class StoreWriter final
+{
+public:
+    static constexpr auto COMMIT_INTERVAL = std::chrono::milliseconds(20);
+    static constexpr size_t GROUP_SIZE = 64;
+
+    explicit StoreWriter(std::string file_path);
+    ~StoreWriter();
+
+    StoreWriter(const StoreWriter&) = delete;
+    StoreWriter& operator=(const StoreWriter&) = delete;
+
+    std::uint64_t Submit(std::shared_ptr<const TaskTable> tasks, unsigned int next_id);
+    bool WaitDurable(std::uint64_t sequence);
+    bool TakeFailure() { return m_failed.exchange(false); }
+    StoreWriterStats Stats() const;
+private:
+    struct Record
+    {
+        std::uint64_t sequence;
+        std::shared_ptr<const TaskTable> tasks;
+        unsigned int next_id;
+        Record *next;
+    };
+
+    void Run();
+    void Commit(Record *records);
+
+    std::string m_file_path;
+
+    std::atomic<Record*> m_head{nullptr};
+    std::atomic<size_t> m_depth{0};
+    std::atomic<std::uint64_t> m_next_sequence{0};
+    std::atomic<size_t> m_max_depth{0};
+    std::atomic<std::uint64_t> m_completed{0};     // Newest sequence a commit was attempted for
+    std::atomic<std::uint64_t> m_durable{0};       // Newest sequence a commit succeeded for
+    std::atomic<size_t> m_sync_waiters{0};
+    std::atomic<bool> m_failed{false};
+    std::atomic<bool> m_stopping{false};
+    std::counting_semaphore<> m_signal{0};
+
+    mutable std::mutex m_stats_mutex;
+    StoreWriterStats m_stats{};
+
+    std::thread m_thread;
+};
+
+#endif //STOREWRITER_H
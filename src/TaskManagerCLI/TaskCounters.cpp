@@ -0,0 +1,46 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "TaskCounters.h"
+
+#include <chrono>
+
+void TaskCounters::Count(const Task& task, const int delta)
+{
+    const auto status = static_cast<size_t>(task.status);
+    const auto priority = static_cast<size_t>(task.priority);
+    const auto step = static_cast<size_t>(delta);     // Wraps around, so -1 counts down
+
+    m_total += step;
+    m_matrix[status][priority] += step;
+
+    if (task.due == 0) {
+        m_undated[status] += step;
+        return;
+    }
+
+    // A week nothing is due in any more is dropped, so the buckets only ever hold the weeks in use
+    const auto it = m_weeks.try_emplace(WeekOf(task.due)).first;
+    it->second[status] += step;
+    if (it->second == WeekCounts{}) m_weeks.erase(it);
+}
+
+void TaskCounters::Clear()
+{
+    m_total = 0;
+    m_matrix = {};
+    m_weeks.clear();
+    m_undated = {};
+}
+
+std::uint32_t TaskCounters::WeekOf(const std::uint32_t date)
+{
+    using namespace std::chrono;
+
+    const sys_days day{year_month_day{year{static_cast<int>(date / 10000)}, month{date / 100 % 100}, std::chrono::day{date % 100}}};
+    const year_month_day monday{day - (weekday{day} - Monday)};
+
+    return static_cast<std::uint32_t>(static_cast<int>(monday.year())) * 10000
+         + static_cast<unsigned>(monday.month()) * 100 + static_cast<unsigned>(monday.day());
+}
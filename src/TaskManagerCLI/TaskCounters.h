@@ -0,0 +1,57 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef TASKCOUNTERS_H
+#define TASKCOUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+
+#include "Tasks.h"
+
+inline constexpr size_t PRIORITY_COUNT = 4;     // `Priority` without `Invalid`
+inline constexpr size_t STATUS_COUNT = 2;       // `Status` without `None`
+
+/* TaskCounters
+ * ------------------------------------------------------------------------------
+ * Aggregate counts behind `report`, maintained incrementally as tasks enter,
+ * change and leave the store, each update O(1):
+ * - a status x priority matrix of task counts;
+ * - per due week (keyed by the Monday starting it, see `WeekOf`) the pending
+ *   and completed tasks due in it, plus the tasks without a due date.
+ * Per-tag counts need no counter of their own, they are the sizes of the tag
+ * postings.
+ */
+class TaskCounters final
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using Matrix = std::array<std::array<size_t, PRIORITY_COUNT>, STATUS_COUNT>;
+    using WeekCounts = std::array<size_t, STATUS_COUNT>;
+
+    explicit TaskCounters(const allocator_type& allocator = {}) : m_weeks(allocator) {}
+
+    void Add(const Task& task) { Count(task, 1); }
+    void Remove(const Task& task) { Count(task, -1); }
+    void Clear();
+
+    size_t Total() const { return m_total; }
+    const Matrix& StatusPriority() const { return m_matrix; }
+    const std::pmr::unordered_map<std::uint32_t, WeekCounts>& DueWeeks() const { return m_weeks; }
+    const WeekCounts& Undated() const { return m_undated; }
+
+    /* The Monday starting the week of a packed date (see `PackDate`), packed the same way */
+    static std::uint32_t WeekOf(std::uint32_t date);
+private:
+    void Count(const Task& task, int delta);
+
+    size_t m_total{0};
+    Matrix m_matrix{};
+    std::pmr::unordered_map<std::uint32_t, WeekCounts> m_weeks;
+    WeekCounts m_undated{};
+};
+
+#endif //TASKCOUNTERS_H
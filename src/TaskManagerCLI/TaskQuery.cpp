@@ -0,0 +1,129 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "TaskQuery.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+/* --------------------Parsing-------------------- */
+
+bool TaskQuery::SplitCondition(const std::string_view condition, std::string_view& field, QueryOp& op, std::string_view& value)
+{
+    // Two-character operators first, so that `<=` is not read as `<` followed by `=value`
+    static constexpr std::array<std::pair<std::string_view, QueryOp>, 6> operators {{
+        {"<=", QueryOp::LessEqual},
+        {">=", QueryOp::GreaterEqual},
+        {"!=", QueryOp::NotEqual},
+        {"=", QueryOp::Equal},
+        {"<", QueryOp::Less},
+        {">", QueryOp::Greater}
+    }};
+
+    const size_t position = condition.find_first_of("<>!=");
+    if (position == 0 || position == std::string_view::npos) return false;
+
+    for (const auto &[symbol, symbol_op] : operators) {
+        if (condition.substr(position).starts_with(symbol)) {
+            field = condition.substr(0, position);
+            value = condition.substr(position + symbol.size());
+            op = symbol_op;
+            return !value.empty();
+        }
+    }
+
+    return false;
+}
+
+QueryField TaskQuery::GetField(const std::string_view field)
+{
+    static constexpr std::array<std::pair<std::string_view, QueryField>, 6> fields {{
+        {"id", QueryField::ID},
+        {"status", QueryField::Status},
+        {"priority", QueryField::Priority},
+        {"due", QueryField::Due},
+        {"tag", QueryField::Tag},
+        {"tags", QueryField::Tag}
+    }};
+
+    const auto it = std::ranges::find(fields, field, &std::pair<std::string_view, QueryField>::first);
+    return it != fields.end() ? it->second : QueryField::None;
+}
+
+void TaskQuery::AddIds(std::vector<IdRange> ranges)
+{
+    ranges.insert(ranges.end(), m_ids.begin(), m_ids.end());
+    std::ranges::sort(ranges, {}, &IdRange::first);
+
+    m_ids.clear();
+    for (const auto &range : ranges) {
+        if (!m_ids.empty() && range.first <= static_cast<size_t>(m_ids.back().last) + 1) {
+            m_ids.back().last = std::max(m_ids.back().last, range.last);
+        } else {
+            m_ids.push_back(range);
+        }
+    }
+}
+
+size_t TaskQuery::IdSpan() const
+{
+    size_t span = 0;
+    for (const auto &range : m_ids) span += static_cast<size_t>(range.last - range.first) + 1;
+    return span;
+}
+
+/* --------------------Matching-------------------- */
+
+bool TaskQuery::ContainsId(const unsigned int id) const
+{
+    // Ranges are sorted and disjoint: the candidate is the last range starting at or before `id`
+    const auto it = std::ranges::upper_bound(m_ids, id, {}, &IdRange::first);
+    return it != m_ids.begin() && id <= std::prev(it)->last;
+}
+
+template <typename T>
+static bool Compare(const T& lhs, const QueryOp op, const T& rhs)
+{
+    switch (op) {
+        case QueryOp::Equal:        return lhs == rhs;
+        case QueryOp::NotEqual:     return lhs != rhs;
+        case QueryOp::Less:         return lhs < rhs;
+        case QueryOp::LessEqual:    return lhs <= rhs;
+        case QueryOp::Greater:      return lhs > rhs;
+        default:                    return lhs >= rhs;
+    }
+}
+
+bool TaskQuery::Matches(const Task& task, const TaskTable& tasks, const QueryCondition& condition)
+{
+    switch (condition.field) {
+        case QueryField::ID:
+            return Compare<unsigned int>(task.id, condition.op, condition.number);
+        case QueryField::Status:
+            return Compare(static_cast<unsigned int>(task.status), condition.op, condition.number);
+        case QueryField::Priority:
+            return Compare(static_cast<unsigned int>(task.priority), condition.op, condition.number);
+        case QueryField::Due:
+            // `due=none` / `due!=none` test for a missing date, a task without one never matches a comparison
+            if (condition.text == "none") return (condition.op == QueryOp::Equal) == (task.due == 0);
+            return task.due != 0 && Compare(task.due, condition.op, condition.number);
+        case QueryField::Tag: {
+            const bool has_tag = tasks.HasTag(task, condition.text);
+            return condition.op == QueryOp::Equal ? has_tag : !has_tag;
+        }
+        default:
+            return false;
+    }
+}
+
+bool TaskQuery::Matches(const Task& task, const TaskTable& tasks) const
+{
+    if (!m_ids.empty() && !ContainsId(task.id)) return false;
+
+    return std::ranges::all_of(m_conditions, [&task, &tasks](const QueryCondition& condition) {
+        return Matches(task, tasks, condition);
+    });
+}
@@ -0,0 +1,90 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef TASKQUERY_H
+#define TASKQUERY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TaskTable.h"
+
+// Task fields a `--where` condition can test
+enum class QueryField
+{
+    ID,
+    Status,
+    Priority,
+    Due,
+    Tag,
+    None
+};
+
+enum class QueryOp
+{
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+/* QueryCondition
+ * ------------------------------------------------------------------------------
+ * One `field<op>value` test. `number` holds the value of ID, status, priority
+ * and due date conditions (the date packed by `PackDate`), `text` the value of
+ * tag conditions and the (normalized) text of due dates. A due date of `none`
+ * matches the tasks without one.
+ */
+struct QueryCondition
+{
+    QueryField field{QueryField::None};
+    QueryOp op{QueryOp::Equal};
+    unsigned int number{0};
+    std::string text;
+};
+
+// Inclusive range of task IDs, a single ID is a range of one
+struct IdRange
+{
+    unsigned int first{0};
+    unsigned int last{0};
+};
+
+/* TaskQuery
+ * ------------------------------------------------------------------------------
+ * Selection of tasks for the bulk forms of `complete`, `delete` and `tag`: an
+ * optional list of ID ranges (`--id 1 5 9-200`) and any number of `--where`
+ * conditions, all of which a task has to satisfy.
+ * - SplitCondition -> Splits `due<2025-01-01` into its field, operator and value.
+ * - AddIds         -> Adds ID ranges, overlapping or adjacent ranges are merged.
+ * - AddCondition   -> Adds a parsed condition.
+ * - IdSpan         -> Number of IDs covered by the ranges (0 without `--id`).
+ * - Matches        -> Whether the task is selected.
+ */
+class TaskQuery final
+{
+public:
+    static bool SplitCondition(std::string_view condition, std::string_view& field, QueryOp& op, std::string_view& value);
+    static QueryField GetField(std::string_view field);
+
+    void AddIds(std::vector<IdRange> ranges);
+    void AddCondition(QueryCondition condition) { m_conditions.push_back(std::move(condition)); }
+
+    bool HasIds() const { return !m_ids.empty(); }
+    const std::vector<IdRange>& Ids() const { return m_ids; }
+    size_t IdSpan() const;
+
+    bool Matches(const Task& task, const TaskTable& tasks) const;
+private:
+    bool ContainsId(unsigned int id) const;
+    static bool Matches(const Task& task, const TaskTable& tasks, const QueryCondition& condition);
+
+    std::vector<IdRange> m_ids{};
+    std::vector<QueryCondition> m_conditions{};
+};
+
+#endif //TASKQUERY_H
@@ -0,0 +1,240 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "TaskTable.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+/* --------------------Construction-------------------- */
+
+TaskTable::TaskTable(const allocator_type& allocator)
+    : m_records(allocator), m_text(allocator), m_tag_ids(allocator), m_tag_names(allocator), m_tag_order(allocator) {}
+
+TaskTable::TaskTable(const TaskTable& other, const allocator_type& allocator)
+    : m_records(other.m_records, allocator), m_text(other.m_text, allocator), m_tag_ids(other.m_tag_ids, allocator),
+      m_tag_names(other.m_tag_names, allocator), m_tag_order(other.m_tag_order, allocator),
+      m_garbage_bytes(other.m_garbage_bytes) {}
+
+TaskTable::TaskTable(TaskTable&& other, const allocator_type& allocator)
+    : m_records(std::move(other.m_records), allocator), m_text(std::move(other.m_text), allocator),
+      m_tag_ids(std::move(other.m_tag_ids), allocator), m_tag_names(std::move(other.m_tag_names), allocator),
+      m_tag_order(std::move(other.m_tag_order), allocator), m_garbage_bytes(other.m_garbage_bytes) {}
+
+/* --------------------Records-------------------- */
+
+Task& TaskTable::push_back(const Task& task, const TaskTable& source)
+{
+    Task record = task;
+    record.description_length = 0;
+    record.tag_count = 0;
+
+    SetDescription(record, source.Description(task));
+    SetTags(record, source.Tags(task));
+
+    return m_records.emplace_back(record);
+}
+
+Task& TaskTable::push_back(const Task& task, const TaskTable& source, const std::span<const std::uint32_t> tag_map)
+{
+    Task record = task;
+    record.description_length = 0;
+    record.tag_count = 0;
+
+    SetDescription(record, source.Description(task));
+
+    const auto source_ids = source.TagIds(task);
+    std::array<std::uint32_t, 16> local_ids;
+    std::vector<std::uint32_t> spilled_ids(source_ids.size() > local_ids.size() ? source_ids.size() : 0);
+    const std::span<std::uint32_t> tag_ids =
+        spilled_ids.empty() ? std::span(local_ids).first(source_ids.size()) : std::span(spilled_ids);
+    std::ranges::transform(source_ids, tag_ids.begin(), [&tag_map](const std::uint32_t tag_id) { return tag_map[tag_id]; });
+    SetTags(record, tag_ids);
+
+    return m_records.emplace_back(record);
+}
+
+void TaskTable::ReserveFor(const TaskTable& source)
+{
+    const auto grow = [](auto &buffer, const size_t added) {
+        if (const size_t needed = buffer.size() + added; needed > buffer.capacity())
+            buffer.reserve(std::max(needed, 2 * buffer.capacity()));
+    };
+
+    grow(m_records, source.m_records.size());
+    grow(m_text, source.m_text.size());
+    grow(m_tag_ids, source.m_tag_ids.size());
+}
+
+void TaskTable::Erase(const std::vector<size_t>& positions)
+{
+    if (positions.empty()) return;
+
+    for (const size_t position : positions) Release(m_records[position]);
+
+    // Survivors are shifted down in a single pass from the first gap onwards
+    size_t write = positions.front();
+    auto doomed = positions.begin();
+    for (size_t read = positions.front(); read < m_records.size(); read++) {
+        if (doomed != positions.end() && *doomed == read) {
+            ++doomed;
+            continue;
+        }
+        m_records[write++] = m_records[read];
+    }
+
+    m_records.resize(write);
+}
+
+void TaskTable::clear()
+{
+    m_records.clear();
+    m_text.clear();
+    m_tag_ids.clear();
+    m_tag_names.clear();
+    m_tag_order.clear();
+    m_garbage_bytes = 0;
+}
+
+void TaskTable::Release(const Task& task)
+{
+    m_garbage_bytes += task.description_length + task.tag_count * sizeof(std::uint32_t);
+}
+
+/* --------------------Text-------------------- */
+
+std::uint32_t TaskTable::AppendText(const std::string_view text)
+{
+    if (text.empty()) return 0;
+
+    // A view into the pool itself would dangle as soon as the pool grows
+    if (!m_text.empty() && std::greater_equal()(text.data(), m_text.data())
+        && std::less()(text.data(), m_text.data() + m_text.size())) {
+        return AppendText(std::string(text));
+    }
+
+    if (m_text.size() + text.size() > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error("The task text pool is full");
+
+    const auto offset = static_cast<std::uint32_t>(m_text.size());
+    m_text.insert(m_text.end(), text.begin(), text.end());
+    return offset;
+}
+
+void TaskTable::SetDescription(Task& task, const std::string_view description)
+{
+    m_garbage_bytes += task.description_length;
+
+    task.description_offset = AppendText(description);
+    task.description_length = static_cast<std::uint32_t>(description.size());
+}
+
+void TaskTable::SetTags(Task& task, const std::span<const std::uint32_t> tag_ids)
+{
+    // A view into the array itself would dangle as soon as the array grows
+    if (!tag_ids.empty() && std::greater_equal()(tag_ids.data(), m_tag_ids.data())
+        && std::less()(tag_ids.data(), m_tag_ids.data() + m_tag_ids.size())) {
+        const std::vector<std::uint32_t> copy(tag_ids.begin(), tag_ids.end());
+        SetTags(task, copy);
+        return;
+    }
+
+    m_garbage_bytes += task.tag_count * sizeof(std::uint32_t);
+    task.tags_offset = static_cast<std::uint32_t>(m_tag_ids.size());
+    task.tag_count = static_cast<std::uint16_t>(tag_ids.size());
+    m_tag_ids.insert(m_tag_ids.end(), tag_ids.begin(), tag_ids.end());
+}
+
+std::uint32_t TaskTable::FindTag(const std::string_view tag) const
+{
+    const auto it = std::ranges::lower_bound(m_tag_order, tag, {}, [this](const std::uint32_t tag_id) {
+        return TagName(tag_id);
+    });
+
+    return it != m_tag_order.end() && TagName(*it) == tag ? *it : NO_TAG;
+}
+
+std::uint32_t TaskTable::InternTag(const std::string_view tag)
+{
+    if (const std::uint32_t tag_id = FindTag(tag); tag_id != NO_TAG) return tag_id;
+
+    const auto tag_id = static_cast<std::uint32_t>(m_tag_names.size());
+    m_tag_names.push_back({AppendText(tag), static_cast<std::uint32_t>(tag.size())});
+
+    const auto position = std::ranges::lower_bound(m_tag_order, TagName(tag_id), {}, [this](const std::uint32_t id) {
+        return TagName(id);
+    });
+    m_tag_order.insert(position, tag_id);
+
+    return tag_id;
+}
+
+std::vector<std::uint32_t> TaskTable::MapTags(const TaskTable& source)
+{
+    std::vector<std::uint32_t> tag_map(source.m_tag_names.size());
+    for (std::uint32_t tag_id = 0; tag_id < tag_map.size(); tag_id++) tag_map[tag_id] = InternTag(source.TagName(tag_id));
+    return tag_map;
+}
+
+bool TaskTable::HasTag(const Task& task, const std::string_view tag) const
+{
+    const std::uint32_t tag_id = FindTag(tag);
+    return tag_id != NO_TAG && std::ranges::find(TagIds(task), tag_id) != TagIds(task).end();
+}
+
+size_t TaskTable::TagsLength(const Task& task) const
+{
+    if (task.tag_count == 0) return 0;
+
+    size_t length = 2 * (task.tag_count - 1);   // Space for ", " between tags
+    for (const std::uint32_t tag_id : TagIds(task)) length += m_tag_names[tag_id].length;
+    return length;
+}
+
+/* --------------------Memory-------------------- */
+
+size_t TaskTable::CapacityBytes() const
+{
+    return m_records.capacity() * sizeof(Task) + m_text.capacity() + m_tag_ids.capacity() * sizeof(std::uint32_t)
+         + m_tag_names.capacity() * sizeof(TextRef) + m_tag_order.capacity() * sizeof(std::uint32_t);
+}
+
+void TaskTable::Compact()
+{
+    size_t text_size = 0, tag_id_count = 0;
+    for (const auto &name : m_tag_names) text_size += name.length;
+    for (const auto &task : m_records) {
+        text_size += task.description_length;
+        tag_id_count += task.tag_count;
+    }
+
+    std::pmr::vector<char> text(get_allocator());
+    std::pmr::vector<std::uint32_t> tag_ids(get_allocator());
+    text.reserve(text_size);
+    tag_ids.reserve(tag_id_count);
+
+    const auto append = [&text](const std::string_view part) {
+        const auto offset = static_cast<std::uint32_t>(text.size());
+        text.insert(text.end(), part.begin(), part.end());
+        return offset;
+    };
+
+    // Tag names keep their IDs, only their text moves
+    for (auto &name : m_tag_names) name.offset = append(Text(name.offset, name.length));
+
+    for (auto &task : m_records) {
+        task.description_offset = append(Description(task));
+
+        const auto tags = TagIds(task);
+        task.tags_offset = static_cast<std::uint32_t>(tag_ids.size());
+        tag_ids.insert(tag_ids.end(), tags.begin(), tags.end());
+    }
+
+    m_text.swap(text);
+    m_tag_ids.swap(tag_ids);
+    m_garbage_bytes = 0;
+}
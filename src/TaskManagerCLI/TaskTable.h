@@ -0,0 +1,182 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef TASKTABLE_H
+#define TASKTABLE_H
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Tasks.h"
+
+/* TaskTable
+ * ------------------------------------------------------------------------------
+ * The tasks of a store: compact `Task` records plus the out-of-line data they
+ * point into, a text pool (descriptions and tag names) and a tag-ID array (the
+ * tag lists). A table is a handful of flat buffers, so copying one (history,
+ * snapshots) is a few block copies instead of one allocation per string.
+ *
+ * Records are reached like the elements of a vector. Their text only through
+ * the table:
+ * - Description / Tags / HasTag -> Read a record's description and tag names.
+ * - SetDescription / SetTags    -> Write them. The pool is append-only, the old
+ *                                  text stays behind as garbage.
+ * - push_back(task, source)     -> Appends a record of another table, text included.
+ *                                  Given a `MapTags` map, its tags skip the name lookups.
+ * - Erase                       -> Removes the records at the given (sorted)
+ *                                  positions, keeping the order of the rest.
+ * - Sparse / Compact            -> Whether more of the pool is garbage than
+ *                                  live, and the rewrite that drops it. Records
+ *                                  keep their positions.
+ *
+ * Tag names are interned once per table: a record's tag list is a run of tag
+ * IDs, and `m_tag_order` keeps the IDs sorted by name for lookups. Offsets are
+ * 32-bit, so a table holds up to 4 GiB of text.
+ */
+class TaskTable final
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using iterator = std::pmr::vector<Task>::iterator;
+    using const_iterator = std::pmr::vector<Task>::const_iterator;
+
+    TaskTable() : TaskTable(allocator_type{}) {}
+    explicit TaskTable(const allocator_type& allocator);
+    TaskTable(const TaskTable& other, const allocator_type& allocator);
+    TaskTable(TaskTable&& other, const allocator_type& allocator);
+
+    TaskTable(const TaskTable&) = default;
+    TaskTable(TaskTable&&) = default;
+    TaskTable& operator=(const TaskTable&) = default;
+    TaskTable& operator=(TaskTable&&) = default;
+
+    allocator_type get_allocator() const { return m_records.get_allocator(); }
+
+    /* Records */
+    size_t size() const { return m_records.size(); }
+    bool empty() const { return m_records.empty(); }
+    size_t capacity() const { return m_records.capacity(); }
+    void reserve(const size_t count) { m_records.reserve(count); }
+    // Room to append every record of `source`, grown geometrically so repeated appends stay amortised
+    void ReserveFor(const TaskTable& source);
+
+    iterator begin() { return m_records.begin(); }
+    iterator end() { return m_records.end(); }
+    const_iterator begin() const { return m_records.begin(); }
+    const_iterator end() const { return m_records.end(); }
+
+    Task& operator[](const size_t position) { return m_records[position]; }
+    const Task& operator[](const size_t position) const { return m_records[position]; }
+    Task& back() { return m_records.back(); }
+
+    // The record's text has to be in this table already (set through this table's setters)
+    Task& push_back(const Task& task) { return m_records.emplace_back(task); }
+    Task& push_back(const Task& task, const TaskTable& source);
+    // Same, with the source's tag IDs translated through a map from `MapTags(source)`
+    Task& push_back(const Task& task, const TaskTable& source, std::span<const std::uint32_t> tag_map);
+    void Erase(const std::vector<size_t>& positions);
+    void clear();
+
+    /* Text */
+    std::string_view Description(const Task& task) const { return Text(task.description_offset, task.description_length); }
+    std::span<const std::uint32_t> TagIds(const Task& task) const { return {m_tag_ids.data() + task.tags_offset, task.tag_count}; }
+    std::string_view TagName(const std::uint32_t tag_id) const { return Text(m_tag_names[tag_id].offset, m_tag_names[tag_id].length); }
+    auto Tags(const Task& task) const
+    {
+        return TagIds(task) | std::views::transform([this](const std::uint32_t tag_id) { return TagName(tag_id); });
+    }
+    bool HasTag(const Task& task, std::string_view tag) const;
+    size_t TagsLength(const Task& task) const;
+
+    void SetDescription(Task& task, std::string_view description);
+    void SetTags(Task& task, std::span<const std::uint32_t> tag_ids);
+    template <typename Range>
+        requires std::convertible_to<std::ranges::range_reference_t<const Range&>, std::string_view>
+    void SetTags(Task& task, const Range& tags);
+
+    // Existing tags are resolved before any is added, so names viewing this table's pool stay valid
+    std::uint32_t FindTag(std::string_view tag) const;
+    std::uint32_t InternTag(std::string_view tag);
+    // This table's ID for every tag ID of `source` (by position), interning the names missing here
+    std::vector<std::uint32_t> MapTags(const TaskTable& source);
+
+    /* Memory */
+    size_t LiveBytes() const { return m_text.size() + m_tag_ids.size() * sizeof(std::uint32_t) - m_garbage_bytes; }
+    size_t GarbageBytes() const { return m_garbage_bytes; }
+    size_t CapacityBytes() const;
+    bool Sparse() const { return m_garbage_bytes > LiveBytes() && m_garbage_bytes >= MIN_SPARSE_BYTES; }
+    void Compact();
+
+    static constexpr std::uint32_t NO_TAG = UINT32_MAX;
+private:
+    struct TextRef
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    std::string_view Text(const std::uint32_t offset, const std::uint32_t length) const { return {m_text.data() + offset, length}; }
+    std::uint32_t AppendText(std::string_view text);
+    void Release(const Task& task);
+
+    // Below this many garbage bytes a compaction is not worth its copy, whatever the ratio
+    static constexpr size_t MIN_SPARSE_BYTES = size_t{1} << 20;
+
+    std::pmr::vector<Task> m_records;
+    std::pmr::vector<char> m_text;
+    std::pmr::vector<std::uint32_t> m_tag_ids;
+    std::pmr::vector<TextRef> m_tag_names;      // By tag ID
+    std::pmr::vector<std::uint32_t> m_tag_order; // Tag IDs sorted by name
+    size_t m_garbage_bytes{0};
+};
+
+template <typename Range>
+    requires std::convertible_to<std::ranges::range_reference_t<const Range&>, std::string_view>
+void TaskTable::SetTags(Task& task, const Range& tags)
+{
+    // Tag lists are short, the IDs are gathered on the stack unless one is not
+    const auto count = static_cast<size_t>(std::ranges::distance(tags));
+    std::array<std::uint32_t, 16> local_ids;
+    std::vector<std::uint32_t> spilled_ids(count > local_ids.size() ? count : 0);
+    const std::span<std::uint32_t> tag_ids = spilled_ids.empty() ? std::span(local_ids).first(count) : std::span(spilled_ids);
+
+    size_t position = 0;
+    for (const auto &tag : tags) tag_ids[position++] = FindTag(tag);
+
+    auto tag = std::ranges::begin(tags);
+    for (auto &tag_id : tag_ids) {
+        if (tag_id == NO_TAG) tag_id = InternTag(*tag);
+        ++tag;
+    }
+
+    SetTags(task, tag_ids);
+}
+
+// Staging buffer holding one parsed import file until it is merged into the store
+struct ImportBatch
+{
+    std::string file_path;
+    TaskTable tasks;
+    std::vector<std::string> warnings;
+    size_t skipped{};
+    bool failed{false};
+    ImportSummary summary;
+};
+
+// Immutable copy of the tasks a serving writer publishes for the readers, already in the active sort order
+struct TaskSnapshot
+{
+    std::uint64_t version{};
+    TaskTable tasks;
+    std::pair<Flag, Order> sort{Flag::None, Order::None};
+};
+
+#endif //TASKTABLE_H
@@ -5,7 +5,12 @@
 #ifndef TASKS_H
 #define TASKS_H
 
+#include <array>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 // Possible commands
@@ -19,11 +24,15 @@ enum class Command
     Search,
     Filter,
     Sort,
+    Next,
+    Report,
     Tag,
     Undo,
     Export,
     Import,
+    Archive,
     Config,
+    Stats,
     Help,
     Exit,
     None
@@ -46,11 +55,25 @@ enum class Flag
     List,
     File,
     DefaultPriority,
+    Mode,
+    Limit,
+    Offset,
+    Top,
+    Where,
+    Rename,
+    Merge,
+    Into,
+    Sync,
+    Json,
+    Memory,
+    Before,
+    IncludeArchived,
+    AutoArchive,
     None
 };
 
 // Possible priorities for the tasks
-enum class Priority
+enum class Priority : std::uint8_t
 {
     None,
     Low,
@@ -59,14 +82,19 @@ enum class Priority
     Invalid
 };
 
+// Display strings indexed by the enum values, so rendering never builds a string per row
+inline constexpr std::array<std::string_view, 5> priority_names = {"none", "low", "medium", "high", "invalid"};
+
 // Possible statuses for the tasks
-enum class Status
+enum class Status : std::uint8_t
 {
     Pending,
     Completed,
     None
 };
 
+inline constexpr std::array<std::string_view, 3> status_names = {"Pending", "Completed", "None"};
+
 enum class Order
 {
     Ascending,
@@ -74,6 +102,15 @@ enum class Order
     None
 };
 
+// Possible ways of resolving imported tasks whose ID already exists
+enum class ImportMode
+{
+    Skip,
+    Upsert,
+    Replace,
+    None
+};
+
 // Possible outputs when validating dates
 enum class DateValidationResult
 {
@@ -90,19 +127,56 @@ enum class RunStatus
     None
 };
 
-// Task structure with all its parameters
+// Compact task record (24 bytes). Its text lives out of line in the `TaskTable` holding it: the description
+// as an offset and length into the table's text pool, the tags as a run of IDs in the table's tag-ID array.
 struct Task
 {
-    Task()
-        : id(0), description(), priority(Priority::None), status(Status::Pending), due(), tags{}, hidden(false) {}
-
-    unsigned short int id;
-    std::string description;
-    Priority priority;
-    Status status;
-    std::string due;
-    std::vector<std::string> tags;
-    bool hidden;
+    unsigned int id{0};
+    std::uint32_t due{0};                   // See `PackDate`
+    std::uint32_t description_offset{0};
+    std::uint32_t description_length{0};
+    std::uint32_t tags_offset{0};
+    std::uint16_t tag_count{0};
+    Priority priority{Priority::None};
+    Status status{Status::Pending};
+};
+
+static_assert(sizeof(Task) == 24, "Task records are packed into 24 bytes");
+
+// Due dates are stored as the number YYYYMMDD, which orders like the ISO text, and 0 for no date
+inline std::uint32_t PackDate(const std::string_view date)
+{
+    if (date.size() != 10) return 0;
+
+    const auto digits = [&date](const size_t first, const size_t count) {
+        std::uint32_t value = 0;
+        for (size_t i = first; i < first + count; i++) value = value * 10 + static_cast<std::uint32_t>(date[i] - '0');
+        return value;
+    };
+
+    return digits(0, 4) * 10000 + digits(5, 2) * 100 + digits(8, 2);
+}
+
+inline std::string FormatDate(std::uint32_t date)
+{
+    if (date == 0) return {};
+
+    std::string text = "0000-00-00";
+    for (const size_t position : {9, 8, 6, 5, 3, 2, 1, 0}) {
+        text[position] = static_cast<char>('0' + date % 10);
+        date /= 10;
+    }
+
+    return text;
+}
+
+// Outcome of merging imported tasks into the store
+struct ImportSummary
+{
+    size_t added{};
+    size_t updated{};
+    size_t unchanged{};
+    size_t skipped{};
 };
 
 #endif //TASKS_H
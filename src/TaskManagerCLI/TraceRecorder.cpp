@@ -0,0 +1,95 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <charconv>
+
+/* --------------------Consts-------------------- */
+
+static constexpr std::string_view TRACE_HEADER = "# tasks trace v1";
+static constexpr std::streamoff TAIL_BYTES = 64 * 1024;     // Read back to find the last offset of a trace
+
+/* --------------------Recording-------------------- */
+
+TraceRecorder::TraceRecorder(const std::string &file_path) : m_file(file_path, std::ios::out | std::ios::app)
+{
+    if (!m_file) return;
+
+    m_file.seekp(0, std::ios::end);
+    if (m_file.tellp() == 0) {
+        m_file << TRACE_HEADER << "\n";
+        return;
+    }
+
+    // A trace that already has commands goes on from its last offset, so the offsets of a session of one-shot
+    // invocations keep increasing and `--paced` replays them back to back
+    std::ifstream previous(file_path, std::ios::binary);
+    const std::streamoff size = previous.seekg(0, std::ios::end).tellg();
+    const std::streamoff tail = std::min<std::streamoff>(size, TAIL_BYTES);
+
+    std::string bytes(static_cast<size_t>(tail), '\0');
+    previous.seekg(size - tail).read(bytes.data(), tail);
+
+    std::uint64_t last_us = 0;
+    std::string_view rest = bytes;
+    while (!rest.empty()) {
+        const size_t end = std::min(rest.find('\n'), rest.size());
+
+        std::uint64_t offset_us;
+        std::string_view command;
+        if (ParseLine(rest.substr(0, end), offset_us, command)) last_us = std::max(last_us, offset_us);
+
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+    }
+
+    m_start -= std::chrono::microseconds(last_us);
+}
+
+bool TraceRecorder::Recordable(const std::string_view word)
+{
+    // `GetInput` has no escapes: a quote always opens or closes a quoted word, and an empty or blank word is an error
+    return !word.empty() && word.find_first_of("\"\r\n") == std::string_view::npos
+           && word.find_first_not_of(' ') != std::string_view::npos;
+}
+
+bool TraceRecorder::Record(const size_t argc, const std::vector<std::string_view> &argv)
+{
+    for (size_t i = 0; i < argc; i++) {
+        if (!Recordable(argv[i])) return false;
+    }
+
+    const auto offset = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+
+    std::lock_guard lock(m_mutex);
+
+    m_line = std::to_string(offset.count());
+    for (size_t i = 0; i < argc; i++) {
+        m_line += ' ';
+
+        // The tokenizer only keeps a word with spaces together when it is quoted
+        const bool quote = argv[i].find(' ') != std::string_view::npos;
+        if (quote) m_line += '"';
+        m_line += argv[i];
+        if (quote) m_line += '"';
+    }
+    m_line += '\n';
+
+    m_file.write(m_line.data(), static_cast<std::streamsize>(m_line.size()));
+    return true;
+}
+
+/* --------------------Parsing-------------------- */
+
+bool TraceRecorder::ParseLine(const std::string_view line, std::uint64_t &offset_us, std::string_view &command)
+{
+    if (line.empty() || line.front() == '#') return false;
+
+    const auto [end, ec] = std::from_chars(line.data(), line.data() + line.size(), offset_us);
+    if (ec != std::errc() || end == line.data() + line.size() || *end != ' ') return false;
+
+    command = line.substr(static_cast<size_t>(end - line.data()) + 1);
+    return !command.empty();
+}
@@ -0,0 +1,57 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* TraceRecorder
+ * ------------------------------------------------------------------------------
+ * `tasks --record FILE ...`: appends every command line the manager handles to a
+ * trace that `tasks-replay` can run again. After a `# tasks trace v1` header,
+ * written when the file is new or empty, there is one line per command:
+ *
+ *     <microseconds since the recording started> <command line>
+ *
+ * A trace can be recorded over several invocations (one-shot commands): each
+ * goes on from the last offset in the file. The command line is written back in
+ * the input grammar, words with spaces in double quotes, so it tokenizes to the
+ * same words. One recorder can be shared by the managers of a serving process,
+ * lines are written under a mutex.
+ * - Record    -> Appends a command. A command with a word the input grammar
+ *                cannot express (one holding `"` or a line break, an empty or
+ *                blank word) is not recorded, and false is returned.
+ * - ParseLine -> Splits a trace line into its offset and command line, false for
+ *                the header, comments and malformed lines.
+ */
+class TraceRecorder final
+{
+public:
+    explicit TraceRecorder(const std::string &file_path);
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    bool IsOpen() const { return m_file.is_open(); }
+
+    bool Record(size_t argc, const std::vector<std::string_view> &argv);
+
+    static bool ParseLine(std::string_view line, std::uint64_t &offset_us, std::string_view &command);
+private:
+    static bool Recordable(std::string_view word);
+
+    std::mutex m_mutex;
+    std::ofstream m_file;
+    std::string m_line;
+    std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
+};
+
+#endif //TRACERECORDER_H
@@ -0,0 +1,247 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Core benchmark suite
+ * ------------------------------------------------------------------------------
+ * Runs the commands through `Manager::HandleCommand` against synthetic stores of
+ * 1k, 10k, ... up to 10M tasks. The stores come from the deterministic generator
+ * in SyntheticTasks.h, so every run measures the same data.
+ *
+ * Each benchmark works inside a batch: history entries and store writes are
+ * deferred to the end of the batch, which never comes, so only the in-memory
+ * work of the command is timed. All output goes to /dev/null.
+ *
+ * Usage: TaskManagerBench [--max-tasks=N] [Google Benchmark flags]
+ *   --max-tasks caps the store sizes (default 10000000, which needs several GB).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Manager.h"
+#include "StoreFile.h"
+#include "SyntheticTasks.h"
+
+namespace fs = std::filesystem;
+
+/* --------------------Fixture-------------------- */
+
+static fs::path scratch_root;
+static size_t max_tasks = 10'000'000;
+
+// Every store size gets its own directory with a `tasks.db`, generated the first time it is needed
+static fs::path StoreDirectory(const size_t count)
+{
+    const fs::path directory = scratch_root / std::to_string(count);
+
+    if (!fs::exists(directory / "tasks.db")) {
+        fs::create_directories(directory);
+        StoreFile::Save((directory / "tasks.db").string(), GenerateTasks(count), static_cast<unsigned int>(count + 1));
+    }
+
+    return directory;
+}
+
+class Session final
+{
+public:
+    explicit Session(const size_t count) : m_null("/dev/null"), m_manager(std::make_unique<Manager>(m_null, m_null))
+    {
+        fs::current_path(StoreDirectory(count));
+
+        m_manager->BeginBatch();
+        Run({"list", "--limit", "1"});    // Loads the store outside the timed loop
+    }
+
+    void Run(const std::vector<std::string_view> &args) { m_manager->HandleCommand(args.size(), args); }
+private:
+    std::ofstream m_null;
+    std::unique_ptr<Manager> m_manager;
+};
+
+/* --------------------Benchmarks-------------------- */
+
+static void BM_Add(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        session.Run({"add", "--description", "benchmark task", "--priority", "high", "--tags", "work", "home"});
+    }
+}
+
+static void BM_EditById(benchmark::State &state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    Session session(count);
+
+    std::mt19937_64 random(7);
+    std::vector<std::string> ids(1024);
+    for (auto &id : ids) id = std::to_string(1 + random() % count);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        session.Run({"edit", "--id", ids[i++ % ids.size()], "--description", "edited task", "--priority", "low"});
+    }
+}
+
+static void BM_DeleteById(benchmark::State &state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    auto session = std::make_unique<Session>(count);
+
+    // Deleting from the back keeps every iteration the same amount of work as the store shrinks by one
+    size_t next = count;
+    std::string id;
+
+    for (auto _ : state) {
+        if (next == 0) {
+            state.PauseTiming();
+            session = std::make_unique<Session>(count);
+            next = count;
+            state.ResumeTiming();
+        }
+
+        id = std::to_string(next--);
+        session->Run({"delete", "--id", id});
+    }
+}
+
+static void BM_SearchKeyword(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"search", "--description", "invoice backup"});
+}
+
+static void BM_SearchTags(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"search", "--tags", "tag7", "tag21"});
+}
+
+static void BM_Filter(benchmark::State &state, const std::vector<std::string_view> args)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run(args);
+}
+
+static void BM_Sort(benchmark::State &state, const std::string_view key)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    // Alternating the order keeps every iteration from starting on already sorted input
+    bool ascending = true;
+    for (auto _ : state) {
+        session.Run({"sort", "--by", key, "--order", ascending ? "asc" : "desc"});
+        ascending = !ascending;
+    }
+}
+
+static void BM_List(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"list"});
+}
+
+static void BM_Next(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"next", "--top", "10"});
+}
+
+static void BM_ListTop(benchmark::State &state)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"list", "--top", "10", "--by", "priority"});
+}
+
+static void BM_Export(benchmark::State &state, const std::string_view file)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) session.Run({"export", "--file", file});
+}
+
+static void BM_Import(benchmark::State &state, const std::string_view file)
+{
+    Session session(static_cast<size_t>(state.range(0)));
+    session.Run({"export", "--file", file});
+
+    for (auto _ : state) session.Run({"import", "--file", file, "--mode", "replace"});
+}
+
+/* --------------------Registration-------------------- */
+
+static void StoreSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for (size_t count = 1'000; count <= max_tasks && count <= 10'000'000; count *= 10) {
+        benchmark->Arg(static_cast<int64_t>(count));
+    }
+    benchmark->Unit(benchmark::kMicrosecond);
+}
+
+int main(int argc, char *argv[])
+{
+    // `--max-tasks` is ours, everything else goes to Google Benchmark
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--max-tasks=")) max_tasks = std::strtoul(argv[i] + arg.find('=') + 1, nullptr, 10);
+        else argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    benchmark::RegisterBenchmark("Add", BM_Add)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Edit/by-id", BM_EditById)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Delete/by-id", BM_DeleteById)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Search/keyword", BM_SearchKeyword)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Search/tags", BM_SearchTags)->Apply(StoreSizes);
+
+    benchmark::RegisterBenchmark("Filter/status", BM_Filter, std::vector<std::string_view>{"filter", "--status", "completed"})->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Filter/priority", BM_Filter, std::vector<std::string_view>{"filter", "--priority", "high"})->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Filter/due", BM_Filter, std::vector<std::string_view>{"filter", "--due", "2025-06-15"})->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Filter/due-range", BM_Filter, std::vector<std::string_view>{"filter", "--due", "2025-03-01", "--to", "2025-04-30"})->Apply(StoreSizes);
+
+    for (const std::string_view key : {"priority", "due", "id", "status"}) {
+        benchmark::RegisterBenchmark(("Sort/" + std::string(key)).c_str(), BM_Sort, key)->Apply(StoreSizes);
+    }
+
+    benchmark::RegisterBenchmark("List/dev-null", BM_List)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("List/top-10-priority", BM_ListTop)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Next/top-10", BM_Next)->Apply(StoreSizes);
+    benchmark::RegisterBenchmark("Report/json", BM_Filter, std::vector<std::string_view>{"report", "--json"})->Apply(StoreSizes);
+
+    for (const std::string_view file : {"bench.csv", "bench.txt", "bench.json", "bench.csv.gz", "bench.txt.gz", "bench.json.gz"}) {
+        benchmark::RegisterBenchmark(("Export/" + std::string(file.substr(6))).c_str(), BM_Export, file)->Apply(StoreSizes);
+        benchmark::RegisterBenchmark(("Import/" + std::string(file.substr(6))).c_str(), BM_Import, file)->Apply(StoreSizes);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    scratch_root = fs::temp_directory_path() / ("tasks-core-bench-" + std::to_string(getpid()));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    fs::current_path(fs::temp_directory_path());
+    fs::remove_all(scratch_root);
+    return 0;
+}
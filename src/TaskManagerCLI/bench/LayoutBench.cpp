@@ -0,0 +1,198 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Task layout benchmark
+ * ------------------------------------------------------------------------------
+ * Compares the two layouts a store's tasks can live in:
+ *   - heap:    the layout before the compact records, every description, due
+ *              date and tag list its own `std::string` / `std::vector` (kept
+ *              here as `LegacyTask`);
+ *   - compact: 24-byte `Task` records in a `TaskTable`, the text in its pool.
+ * For synthetic stores of 10k, 100k, ... tasks it times an import the way the
+ * manager runs one (parse into staged batches, then merge them into the store),
+ * reads the resident set it added and times the teardown of the whole store.
+ * Every case runs in a forked child, so no case inherits another's heap, and
+ * the best of a few runs is reported.
+ *
+ * Usage: TaskManagerLayoutBench [--max-tasks=N]   (default 10000000, which needs about 2 GB)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SyntheticTasks.h"
+
+static constexpr size_t BATCH_SIZE = 10'000;
+static constexpr int RUNS = 3;
+
+struct LegacyTask
+{
+    unsigned int id;
+    std::string description;
+    Priority priority;
+    Status status;
+    std::string due;
+    std::vector<std::string> tags;
+};
+
+struct Result
+{
+    double import_ms{};
+    double teardown_ms{};
+    long resident_kb{};
+};
+
+static long ResidentKb()
+{
+    std::ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    statm >> size >> resident;
+
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static double Since(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Copying a source task is the allocation pattern of parsing one: all of its text is built anew
+static std::unique_ptr<std::vector<LegacyTask>> ImportLegacy(const TaskTable &source)
+{
+    auto store = std::make_unique<std::vector<LegacyTask>>();
+
+    for (size_t first = 0; first < source.size(); first += BATCH_SIZE) {
+        const size_t last = std::min(source.size(), first + BATCH_SIZE);
+
+        std::vector<LegacyTask> batch;
+        batch.reserve(last - first);
+        for (size_t i = first; i < last; i++) {
+            const Task& task = source[i];
+            const auto tags = source.Tags(task);
+            batch.push_back({task.id, std::string(source.Description(task)), task.priority, task.status,
+                             FormatDate(task.due), std::vector<std::string>(tags.begin(), tags.end())});
+        }
+
+        if (const size_t needed = store->size() + batch.size(); needed > store->capacity())
+            store->reserve(std::max(needed, 2 * store->capacity()));
+        for (auto &task : batch) store->push_back(std::move(task));
+    }
+
+    return store;
+}
+
+static std::unique_ptr<TaskTable> ImportCompact(const TaskTable &source)
+{
+    auto store = std::make_unique<TaskTable>();
+
+    for (size_t first = 0; first < source.size(); first += BATCH_SIZE) {
+        const size_t last = std::min(source.size(), first + BATCH_SIZE);
+
+        TaskTable batch;
+        batch.reserve(last - first);
+        for (size_t i = first; i < last; i++) batch.push_back(source[i], source);
+
+        store->ReserveFor(batch);
+        const std::vector<std::uint32_t> tag_map = store->MapTags(batch);
+        for (const auto &task : batch) store->push_back(task, batch, tag_map);
+    }
+
+    return store;
+}
+
+template <typename Import>
+static Result Measure(const TaskTable &source, const Import &import)
+{
+    const long resident_before = ResidentKb();
+    Result result;
+
+    auto start = std::chrono::steady_clock::now();
+    auto store = import(source);
+    result.import_ms = Since(start);
+    result.resident_kb = ResidentKb() - resident_before;
+
+    start = std::chrono::steady_clock::now();
+    store.reset();
+    result.teardown_ms = Since(start);
+
+    return result;
+}
+
+static Result MeasureInChild(const TaskTable &source, const bool compact)
+{
+    int channel[2];
+    if (pipe(channel) != 0) std::exit(1);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(channel[0]);
+        const Result result = compact ? Measure(source, ImportCompact) : Measure(source, ImportLegacy);
+        if (write(channel[1], &result, sizeof(result)) != sizeof(result)) _exit(1);
+        _exit(0);
+    }
+
+    close(channel[1]);
+    Result result;
+    const bool received = read(channel[0], &result, sizeof(result)) == sizeof(result);
+    close(channel[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (!received) {
+        std::cerr << "A measurement child failed\n";
+        std::exit(1);
+    }
+
+    return result;
+}
+
+int main(const int argc, const char *argv[])
+{
+    size_t max_tasks = 10'000'000;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--max-tasks=")) max_tasks = std::strtoul(argv[i] + arg.find('=') + 1, nullptr, 10);
+    }
+
+    std::cout << std::left << std::setw(10) << "tasks" << std::setw(8) << "layout" << std::right
+              << std::setw(14) << "import (ms)" << std::setw(14) << "tasks / ms" << std::setw(14) << "RSS (KiB)"
+              << std::setw(12) << "B / task" << std::setw(16) << "teardown (ms)" << "\n";
+
+    for (size_t count = 10'000; count <= max_tasks; count *= 10) {
+        const TaskTable source = GenerateTasks(count);
+
+        for (const bool compact : {false, true}) {
+            Result best{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), 0};
+            for (int run = 0; run < RUNS; run++) {
+                const Result result = MeasureInChild(source, compact);
+                best.import_ms = std::min(best.import_ms, result.import_ms);
+                best.teardown_ms = std::min(best.teardown_ms, result.teardown_ms);
+                best.resident_kb = std::max(best.resident_kb, result.resident_kb);
+            }
+
+            std::cout << std::left << std::setw(10) << count << std::setw(8) << (compact ? "compact" : "heap")
+                      << std::right << std::fixed << std::setprecision(2) << std::setw(14) << best.import_ms
+                      << std::setw(14) << std::setprecision(0) << static_cast<double>(count) / best.import_ms
+                      << std::setw(14) << best.resident_kb
+                      << std::setw(12) << static_cast<double>(best.resident_kb) * 1024 / static_cast<double>(count)
+                      << std::setw(16) << std::setprecision(3)
+                      << best.teardown_ms << "\n";
+        }
+    }
+
+    return 0;
+}
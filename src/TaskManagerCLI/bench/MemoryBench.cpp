@@ -0,0 +1,113 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Memory accounting check
+ * ------------------------------------------------------------------------------
+ * Loads synthetic stores of 1k, 10k, ... tasks into a manager and checks what
+ * `stats --memory` reports against two independent totals:
+ *   - the allocator: glibc's in-use heap (mallinfo2) grows by at least the bytes
+ *     reported, and the bytes reported cover most of that growth (the rest is
+ *     malloc's per-chunk overhead and the manager's unaccounted buffers);
+ *   - the layout: the tasks' bytes are exactly what the capacities of their
+ *     table add up to (records, text pool, tag-ID array and tag dictionary).
+ * Prints the breakdown per subsystem and the bytes per task, and exits non-zero
+ * if a check fails.
+ *
+ * Usage: TaskManagerMemoryBench [--max-tasks=N]   (default 100000)
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "Manager.h"
+#include "MemoryAccounting.h"
+#include "StoreFile.h"
+#include "SyntheticTasks.h"
+
+namespace fs = std::filesystem;
+
+static bool Check(const bool passed, const std::string_view what)
+{
+    if (!passed) std::cerr << "  ❌ " << what << "\n";
+    return passed;
+}
+
+int main(const int argc, const char *argv[])
+{
+    size_t max_tasks = 100'000;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--max-tasks=")) max_tasks = std::strtoul(argv[i] + arg.find('=') + 1, nullptr, 10);
+    }
+
+    const auto scratch = fs::temp_directory_path() / ("tasks-memory-bench-" + std::to_string(getpid()));
+    bool passed = true;
+
+    std::cout << std::left << std::setw(10) << "tasks" << std::right << std::setw(14) << "tasks (B)"
+              << std::setw(14) << "id_index (B)" << std::setw(14) << "tags (B)" << std::setw(14) << "history (B)"
+              << std::setw(14) << "B / task" << std::setw(14) << "heap (B)" << std::setw(11) << "coverage" << "\n";
+
+    for (size_t count = 1'000; count <= max_tasks; count *= 10) {
+        const fs::path directory = scratch / std::to_string(count);
+        fs::create_directories(directory);
+        fs::current_path(directory);
+        StoreFile::Save("tasks.db", GenerateTasks(count), static_cast<unsigned int>(count + 1));
+
+        // The same store loaded outside the manager, on a resource of its own
+        CountingResource reference_memory;
+        TaskTable reference(&reference_memory);
+        unsigned int next_id;
+        StoreFile::Load("tasks.db", reference, next_id);
+
+        std::ostringstream output;
+        const size_t heap_before = mallinfo2().uordblks;
+
+        auto manager = std::make_unique<Manager>(output, output);
+        const std::vector<std::string_view> load = {"list", "--limit", "0"};
+        manager->HandleCommand(load.size(), load);
+
+        const size_t heap_growth = mallinfo2().uordblks - heap_before;
+
+        output.str("");
+        const std::vector<std::string_view> stats = {"stats", "--memory", "--json"};
+        manager->HandleCommand(stats.size(), stats);
+
+        const nlohmann::json memory = nlohmann::json::parse(output.str())["memory"];
+        const size_t tasks_bytes = memory["tasks"]["bytes"];
+        const size_t total_bytes = memory["total"]["bytes"];
+        const double coverage = static_cast<double>(total_bytes) / static_cast<double>(heap_growth);
+
+        std::cout << std::left << std::setw(10) << count << std::right << std::setw(14) << tasks_bytes
+                  << std::setw(14) << memory["id_index"]["bytes"].get<size_t>()
+                  << std::setw(14) << memory["tags"]["bytes"].get<size_t>()
+                  << std::setw(14) << memory["history"]["bytes"].get<size_t>()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << static_cast<double>(tasks_bytes) / static_cast<double>(count)
+                  << std::setw(14) << heap_growth << std::setw(10) << coverage * 100 << "%\n";
+
+        passed &= Check(memory["tasks"]["objects"].get<size_t>() == count, "the task count differs from the store");
+        passed &= Check(reference_memory.Bytes() == reference.CapacityBytes(), "a counting resource disagrees with the layout of its tasks");
+        passed &= Check(tasks_bytes == reference_memory.Bytes(), "the manager's tasks differ from the same store loaded on its own");
+        passed &= Check(total_bytes <= heap_growth, "more bytes are reported than the heap grew by");
+        passed &= Check(coverage >= 0.6, "less than 60% of the heap growth is accounted to a subsystem");
+    }
+
+    fs::current_path(fs::temp_directory_path());
+    fs::remove_all(scratch);
+
+    std::cout << (passed ? "✅ Every subsystem matches the allocator totals\n" : "❌ The memory accounting is off\n");
+    return passed ? 0 : 1;
+}
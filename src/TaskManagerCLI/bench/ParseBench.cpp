@@ -0,0 +1,147 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Command/flag parsing benchmark
+ * ------------------------------------------------------------------------------
+ * Resolves every command word and flag of a synthetic batch script, once the way
+ * the parser used to (lowercased copy + `std::unordered_map<std::string, ...>`)
+ * and once through the compile-time perfect-hash registry, and reports the time
+ * per token for both.
+ *
+ * Usage: TaskManagerParseBench [lines] [rounds]
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../CommandRegistry.h"
+
+/* --------------------Baseline-------------------- */
+
+// The lookup tables as they were before the registry, built from the same specs
+template <typename Value, typename Spec, size_t N, typename Projection>
+static std::unordered_map<std::string, Value> MakeHashMap(const std::array<Spec, N> &specs, Projection value_of)
+{
+    std::unordered_map<std::string, Value> map;
+    for (const auto &spec : specs) {
+        map.emplace(spec.name, value_of(spec));
+        map.emplace(spec.alias, value_of(spec));
+    }
+    return map;
+}
+
+static void ToLower(std::string &str)
+{
+    std::ranges::transform(str, str.begin(), [](const unsigned char c) { return std::tolower(c); });
+}
+
+/* --------------------Corpus-------------------- */
+
+// Tokenized lines of a batch script: the command word first, then `--flag value` pairs
+static std::vector<std::vector<std::string>> MakeCorpus(const size_t lines)
+{
+    static const std::vector<std::vector<std::string>> templates = {
+        {"add", "--description", "x", "--priority", "high", "--tags", "work"},
+        {"Edit", "--id", "1", "--Status", "completed", "--due", "2026-01-01"},
+        {"ls", "--limit", "20", "--offset", "40"},
+        {"search", "--tg", "work"},
+        {"filter", "--priority", "low", "--due", "2026-01-01", "--to", "2026-02-01"},
+        {"tag", "--id", "2", "--add", "urgent"},
+        {"sort", "--by", "priority", "--order", "desc"},
+        {"complete", "--i", "7"},
+    };
+
+    std::vector<std::vector<std::string>> corpus;
+    corpus.reserve(lines);
+    for (size_t i = 0; i < lines; i++) corpus.push_back(templates[i % templates.size()]);
+    return corpus;
+}
+
+/* --------------------Measurement-------------------- */
+
+template <typename Resolve>
+static double NanosecondsPerToken(const std::vector<std::vector<std::string>> &corpus, const size_t rounds, Resolve resolve)
+{
+    size_t tokens = 0;
+    size_t checksum = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t round = 0; round < rounds; round++) {
+        for (const auto &line : corpus) {
+            checksum += resolve(line, tokens);
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    // Keeps the optimizer from dropping the lookups
+    if (checksum == static_cast<size_t>(-1)) std::cout << "";
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(tokens);
+}
+
+int main(const int argc, const char *argv[])
+{
+    const size_t lines = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+
+    if (lines == 0 || rounds == 0) {
+        std::cerr << "Usage: TaskManagerParseBench [lines] [rounds]\n";
+        return 1;
+    }
+
+    const auto corpus = MakeCorpus(lines);
+    const auto command_map = MakeHashMap<Command>(command_specs, [](const CommandSpec &spec) { return spec.command; });
+    const auto flag_map = MakeHashMap<Flag>(flag_specs, [](const FlagSpec &spec) { return spec.flag; });
+
+    const double baseline = NanosecondsPerToken(corpus, rounds, [&](const std::vector<std::string> &line, size_t &tokens) {
+        size_t sum = 0;
+
+        std::string command_str = line[0];
+        ToLower(command_str);
+        const auto command = command_map.find(command_str);
+        sum += command != command_map.end() ? static_cast<size_t>(command->second) : 0;
+        tokens++;
+
+        for (size_t i = 1; i < line.size(); i += 2) {
+            std::string flag_str = line[i].substr(2);
+            ToLower(flag_str);
+            const auto flag = flag_map.find(flag_str);
+            sum += flag != flag_map.end() ? static_cast<size_t>(flag->second) : 0;
+            tokens++;
+        }
+
+        return sum;
+    });
+
+    const double registry = NanosecondsPerToken(corpus, rounds, [](const std::vector<std::string> &line, size_t &tokens) {
+        size_t sum = static_cast<size_t>(LookupCommand(line[0]));
+        tokens++;
+
+        for (size_t i = 1; i < line.size(); i += 2) {
+            sum += static_cast<size_t>(LookupFlag(std::string_view(line[i]).substr(2)));
+            tokens++;
+        }
+
+        return sum;
+    });
+
+    std::cout << "Command/flag resolution over " << lines << " batch lines x " << rounds << " rounds\n"
+              << std::left << std::setw(36) << "lookup" << std::right << std::setw(12) << "ns/token" << "\n"
+              << std::fixed << std::setprecision(2)
+              << std::left << std::setw(36) << "lowercase copy + unordered_map" << std::right << std::setw(12) << baseline << "\n"
+              << std::left << std::setw(36) << "perfect-hash registry" << std::right << std::setw(12) << registry << "\n"
+              << std::left << std::setw(36) << "speedup" << std::right << std::setw(11) << baseline / registry << "x\n";
+
+    return 0;
+}
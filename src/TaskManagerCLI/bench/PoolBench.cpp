@@ -0,0 +1,191 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Buffer pool benchmark
+ * ------------------------------------------------------------------------------
+ * Runs the commands of the bounded-memory mode against one synthetic store, with
+ * the tasks in memory and through buffer pools of 4 to 1024 pages (64 KiB each):
+ *   - open:   the first command, which loads the store (or, for a pool, streams
+ *             it once to build the indexes);
+ *   - list, search (by tag) and export (csv): full sequential passes, reported
+ *             in tasks per second;
+ *   - pages:  random `list --limit 10 --offset X` reads, 90% of them within the
+ *             first tenth of the store, reported in reads per second, with the
+ *             hit rate of the pool over the whole case.
+ * Every case runs in a forked child that first drops the store from the page
+ * cache, so the passes read from disk and read-ahead is part of what is timed;
+ * the child's peak resident set is reported as well.
+ *
+ * Usage: TaskManagerPoolBench [--tasks=N]   (default 1000000)
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "Manager.h"
+#include "StoreFile.h"
+#include "SyntheticTasks.h"
+
+namespace fs = std::filesystem;
+
+static constexpr size_t PAGE_READS = 2'000;
+
+struct Result
+{
+    double open_ms{};
+    double list_ms{};
+    double search_ms{};
+    double export_ms{};
+    double pages_ms{};
+    double hit_rate{};
+    long resident_kb{};
+};
+
+// Tables of a million rows are rendered into this, only their cost is of interest
+class NullBuffer final : public std::streambuf
+{
+protected:
+    int_type overflow(const int_type c) override { return c; }
+    std::streamsize xsputn(const char*, const std::streamsize count) override { return count; }
+};
+
+static double Run(Manager &manager, const std::vector<std::string_view> &command)
+{
+    const auto start = std::chrono::steady_clock::now();
+    manager.HandleCommand(command.size(), command);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static Result Measure(const size_t pool_pages, const size_t count)
+{
+    // Cold start: whatever of the store the page cache holds is dropped
+    if (const int fd = open("tasks.db", O_RDONLY | O_CLOEXEC); fd != -1) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+
+    NullBuffer null_buffer;
+    std::ostream output(&null_buffer);
+    std::ostringstream stats_output;
+
+    Manager manager(output, output);
+    if (pool_pages != 0) manager.UsePagedStore(pool_pages);
+
+    Result result;
+    result.open_ms = Run(manager, {"report"});
+    result.list_ms = Run(manager, {"list"});
+    result.search_ms = Run(manager, {"search", "--tags", "tag7"});
+    result.export_ms = Run(manager, {"export", "--file", "pool-bench.csv"});
+
+    std::mt19937_64 random(20261019);
+    std::vector<std::string> offsets(PAGE_READS);
+    for (auto &offset : offsets) {
+        const size_t range = random() % 10 < 9 ? count / 10 : count;
+        offset = std::to_string(random() % std::max<size_t>(range, 1));
+    }
+
+    for (const auto &offset : offsets) result.pages_ms += Run(manager, {"list", "--limit", "10", "--offset", offset});
+
+    // The manager keeps its stream, only where the stream writes to is switched for the stats
+    if (pool_pages != 0) {
+        output.rdbuf(stats_output.rdbuf());
+        Run(manager, {"stats", "--json"});
+
+        const nlohmann::json pool = nlohmann::json::parse(stats_output.str())["pool"];
+        const double hits = pool["hits"].get<double>(), misses = pool["misses"].get<double>();
+        result.hit_rate = hits / std::max(hits + misses, 1.0);
+    }
+
+    return result;
+}
+
+static Result MeasureInChild(const size_t pool_pages, const size_t count)
+{
+    int channel[2];
+    if (pipe(channel) != 0) std::exit(1);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(channel[0]);
+        const Result result = Measure(pool_pages, count);
+        if (write(channel[1], &result, sizeof(result)) != sizeof(result)) _exit(1);
+        _exit(0);
+    }
+
+    close(channel[1]);
+    Result result;
+    const bool received = read(channel[0], &result, sizeof(result)) == sizeof(result);
+    close(channel[0]);
+
+    int status;
+    rusage usage{};
+    wait4(pid, &status, 0, &usage);
+    if (!received) {
+        std::cerr << "A measurement child failed\n";
+        std::exit(1);
+    }
+
+    result.resident_kb = usage.ru_maxrss;
+    return result;
+}
+
+int main(const int argc, const char *argv[])
+{
+    size_t count = 1'000'000;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--tasks=")) count = std::strtoul(argv[i] + arg.find('=') + 1, nullptr, 10);
+    }
+
+    const auto scratch = fs::temp_directory_path() / ("tasks-pool-bench-" + std::to_string(getpid()));
+    fs::create_directories(scratch);
+    fs::current_path(scratch);
+
+    // The children inherit this process, so the generated tasks are gone before the first one forks
+    StoreFile::Save("tasks.db", GenerateTasks(count), static_cast<unsigned int>(count + 1));
+    malloc_trim(0);
+
+    std::cout << count << " tasks, " << fs::file_size("tasks.db") / 1024 << " KiB store, pages of "
+              << PagedStore::PAGE_BYTES / 1024 << " KiB\n";
+    std::cout << std::left << std::setw(10) << "pool" << std::right << std::setw(11) << "open (ms)"
+              << std::setw(14) << "list (t/s)" << std::setw(14) << "search (t/s)" << std::setw(14) << "export (t/s)"
+              << std::setw(14) << "pages (r/s)" << std::setw(10) << "hit rate" << std::setw(12) << "RSS (MiB)" << "\n";
+
+    for (const size_t pool_pages : {size_t{0}, size_t{4}, size_t{16}, size_t{64}, size_t{256}, size_t{1024}}) {
+        const Result result = MeasureInChild(pool_pages, count);
+        const auto per_second = [count](const double ms) { return static_cast<double>(count) / ms * 1000; };
+
+        std::cout << std::left << std::setw(10) << (pool_pages == 0 ? "memory" : std::to_string(pool_pages))
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(11) << result.open_ms
+                  << std::setprecision(0) << std::setw(14) << per_second(result.list_ms)
+                  << std::setw(14) << per_second(result.search_ms) << std::setw(14) << per_second(result.export_ms)
+                  << std::setw(14) << static_cast<double>(PAGE_READS) / result.pages_ms * 1000;
+
+        if (pool_pages == 0) std::cout << std::setw(10) << "-";
+        else std::cout << std::setw(9) << std::setprecision(1) << result.hit_rate * 100 << "%";
+
+        std::cout << std::setw(12) << std::setprecision(1) << static_cast<double>(result.resident_kb) / 1024 << "\n";
+    }
+
+    fs::current_path(fs::temp_directory_path());
+    fs::remove_all(scratch);
+    return 0;
+}
@@ -0,0 +1,155 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * tasks-replay
+ * ------------------------------------------------------------------------------
+ * Runs a trace recorded with `tasks --record TRACE` through a fresh manager in a
+ * scratch directory, starting from an empty store or from a copy of `--store`.
+ * Commands go back to back by default; `--paced` keeps the gaps of the recording.
+ * Output is discarded. Reports the latency percentiles per command and the total
+ * throughput.
+ *
+ * Usage: tasks-replay TRACE [--store tasks.db] [--paced] [--repeat N]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "CommandLine.h"
+#include "CommandRegistry.h"
+#include "Manager.h"
+#include "TraceRecorder.h"
+
+namespace fs = std::filesystem;
+
+struct TraceCommand
+{
+    std::uint64_t offset_us;
+    std::string line;
+};
+
+static void Report(const std::string_view name, std::vector<double> &samples)
+{
+    std::ranges::sort(samples);
+    const auto percentile = [&samples](const double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+    };
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << samples.size()
+              << std::setw(12) << percentile(0.50)
+              << std::setw(12) << percentile(0.95)
+              << std::setw(12) << percentile(0.99)
+              << std::setw(12) << samples.back() << "\n";
+}
+
+int main(const int argc, const char *argv[])
+{
+    std::string trace_path, store_path;
+    bool paced = false;
+    bool valid = true;
+    size_t repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--paced") paced = true;
+        else if (arg == "--store" && i + 1 < argc) store_path = fs::absolute(argv[++i]).string();
+        else if (arg == "--repeat" && i + 1 < argc) repeat = std::strtoul(argv[++i], nullptr, 10);
+        else if (trace_path.empty() && !arg.starts_with("--")) trace_path = fs::absolute(argv[i]).string();
+        else valid = false;
+    }
+
+    if (!valid || trace_path.empty() || repeat == 0) {
+        std::cerr << "Usage: tasks-replay TRACE [--store tasks.db] [--paced] [--repeat N]\n";
+        return 1;
+    }
+
+    std::ifstream trace(trace_path);
+    if (!trace) {
+        std::cerr << "Unable to open trace " << trace_path << "\n";
+        return 1;
+    }
+
+    std::vector<TraceCommand> commands;
+    for (std::string line; std::getline(trace, line);) {
+        std::uint64_t offset_us;
+        std::string_view command;
+        if (TraceRecorder::ParseLine(line, offset_us, command)) commands.push_back({offset_us, std::string(command)});
+    }
+
+    if (commands.empty()) {
+        std::cerr << "The trace " << trace_path << " holds no commands\n";
+        return 1;
+    }
+
+    const auto scratch = fs::temp_directory_path() / ("tasks-replay-" + std::to_string(getpid()));
+    fs::create_directories(scratch);
+    if (!store_path.empty()) fs::copy_file(store_path, scratch / "tasks.db");
+    fs::current_path(scratch);
+
+    std::map<std::string_view, std::vector<double>> latencies;
+    std::vector<double> all;
+    all.reserve(commands.size() * repeat);
+
+    std::chrono::steady_clock::duration busy{};
+
+    {
+        std::ofstream null("/dev/null");
+        Manager manager(null, null);
+        CommandLine line;
+
+        for (size_t round = 0; round < repeat; round++) {
+            const auto round_start = std::chrono::steady_clock::now();
+
+            for (const auto &[offset_us, text] : commands) {
+                if (paced) std::this_thread::sleep_until(round_start + std::chrono::microseconds(offset_us));
+
+                bool empty_quotes;
+                GetInput(text, line, empty_quotes);
+                if (line.tokens.empty() || empty_quotes) continue;
+
+                const Command command = LookupCommand(line.tokens[0]);
+                const std::string_view name = command == Command::None ? "unknown" : GetCommandSpec(command).name;
+
+                const auto start = std::chrono::steady_clock::now();
+                manager.HandleCommand(line.tokens.size(), line.tokens);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+
+                busy += elapsed;
+                const double us = std::chrono::duration<double, std::micro>(elapsed).count();
+                latencies[name].push_back(us);
+                all.push_back(us);
+            }
+        }
+    }
+
+    std::cout << "Replayed " << all.size() << " commands from " << trace_path << (paced ? " at recorded pacing" : "")
+              << (store_path.empty() ? " on an empty store" : " on a copy of " + store_path) << "\n"
+              << std::left << std::setw(12) << "command" << std::right << std::setw(10) << "count"
+              << std::setw(12) << "p50 (us)" << std::setw(12) << "p95 (us)" << std::setw(12) << "p99 (us)"
+              << std::setw(12) << "max (us)" << "\n";
+
+    for (auto &[name, samples] : latencies) Report(name, samples);
+    Report("all", all);
+
+    const double seconds = std::chrono::duration<double>(busy).count();
+    std::cout << std::setprecision(0) << "throughput: " << static_cast<double>(all.size()) / seconds
+              << " commands/s (time spent in commands)\n";
+
+    fs::current_path(fs::temp_directory_path());
+    fs::remove_all(scratch);
+    return 0;
+}
@@ -0,0 +1,198 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Server load generator
+ * ------------------------------------------------------------------------------
+ * Starts `TaskManagerCLI --serve` inside a scratch directory, seeds it with tasks,
+ * then has concurrent clients send a read-heavy mix of commands (~90% `list` and
+ * `search`, ~10% `add`), each waiting for its reply before sending the next.
+ * Reports the throughput and the request latency percentiles.
+ *
+ * Every `add` carries a tag of its own, and the client's next request searches
+ * for it: reads run on published snapshots, so a read sent after a write was
+ * acknowledged has to see that write. Any read that does not is reported as stale
+ * and makes the run fail.
+ *
+ * Usage: TaskManagerServeBench [clients] [requests-per-client] [path-to-TaskManagerCLI]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+static constexpr size_t SEED_TASKS = 1000;
+
+static int Connect(const std::string &path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd != -1 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) return fd;
+
+    if (fd != -1) close(fd);
+    return -1;
+}
+
+// Sends one request line and reads its `<length>\n<body>` reply, false if the server went away
+static bool RoundTrip(const int fd, const std::string &request, std::string &buffer)
+{
+    for (size_t sent = 0; sent < request.size();) {
+        const ssize_t count = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (count <= 0) return false;
+        sent += static_cast<size_t>(count);
+    }
+
+    buffer.clear();
+    size_t header_end = std::string::npos;
+    size_t body_size = 0;
+    char chunk[64 * 1024];
+
+    while (true) {
+        if (header_end == std::string::npos && (header_end = buffer.find('\n')) != std::string::npos) {
+            body_size = std::strtoul(buffer.c_str(), nullptr, 10);
+        }
+        if (header_end != std::string::npos && buffer.size() >= header_end + 1 + body_size) return true;
+
+        const ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) return false;
+        buffer.append(chunk, static_cast<size_t>(count));
+    }
+}
+
+int main(const int argc, const char *argv[])
+{
+    const size_t clients = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    const size_t requests = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    const std::string executable = std::filesystem::absolute(argc > 3 ? argv[3] : TASKS_EXECUTABLE).string();
+
+    if (clients == 0 || requests == 0) {
+        std::cerr << "Usage: TaskManagerServeBench [clients] [requests-per-client] [path-to-TaskManagerCLI]\n";
+        return 1;
+    }
+
+    const auto scratch = std::filesystem::temp_directory_path() / ("tasks-serve-bench-" + std::to_string(getpid()));
+    std::filesystem::create_directories(scratch);
+    std::filesystem::current_path(scratch);
+    const std::string socket_path = (scratch / "tasks.sock").string();
+
+    // The server's banner and shutdown message are not part of the report
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+    std::vector<char*> server_argv = {const_cast<char*>(executable.c_str()), const_cast<char*>("--serve"),
+                                      const_cast<char*>(socket_path.c_str()), nullptr};
+    pid_t server;
+    if (posix_spawn(&server, executable.c_str(), &actions, nullptr, server_argv.data(), environ) != 0) {
+        std::cerr << "Unable to launch " << executable << "\n";
+        return 1;
+    }
+    posix_spawn_file_actions_destroy(&actions);
+
+    int seed_fd = -1;
+    for (int attempt = 0; attempt < 500 && (seed_fd = Connect(socket_path)) == -1; attempt++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (seed_fd == -1) {
+        std::cerr << "The server did not start listening on " << socket_path << "\n";
+        kill(server, SIGTERM);
+        waitpid(server, nullptr, 0);
+        return 1;
+    }
+
+    std::string reply;
+    for (size_t i = 0; i < SEED_TASKS; i++) {
+        RoundTrip(seed_fd, "add --description \"seed task " + std::to_string(i) + "\" --tags bench\n", reply);
+    }
+    close(seed_fd);
+
+    std::vector<std::vector<double>> latencies(clients);
+    std::atomic<size_t> stale_reads{0};
+    std::vector<std::thread> threads;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t client = 0; client < clients; client++) {
+        threads.emplace_back([&, client] {
+            const int fd = Connect(socket_path);
+            if (fd == -1) return;
+
+            std::string buffer;
+            auto &samples = latencies[client];
+            samples.reserve(requests);
+
+            for (size_t i = 0; i < requests; i++) {
+                const std::string probe = "probe-" + std::to_string(client) + "-" + std::to_string(i - i % 10);
+
+                std::string request;
+                switch (i % 10) {
+                    case 0:  request = "add --description \"client " + std::to_string(client) + " task\" --tags bench " + probe + "\n"; break;
+                    case 1:  request = "search --tags " + probe + "\n"; break;
+                    case 4:
+                    case 7:  request = "search --tags bench\n"; break;
+                    default: request = "list --limit 10\n"; break;
+                }
+
+                const auto sent = std::chrono::steady_clock::now();
+                if (!RoundTrip(fd, request, buffer)) break;
+                samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sent).count());
+
+                if (i % 10 == 1 && buffer.find("No tasks available") != std::string::npos) stale_reads++;
+            }
+
+            close(fd);
+        });
+    }
+
+    for (auto &thread : threads) thread.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    kill(server, SIGTERM);
+    waitpid(server, nullptr, 0);
+
+    std::vector<double> samples;
+    for (const auto &client_samples : latencies) samples.insert(samples.end(), client_samples.begin(), client_samples.end());
+
+    if (samples.empty()) {
+        std::cerr << "No request completed\n";
+        return 1;
+    }
+
+    std::ranges::sort(samples);
+    const auto percentile = [&samples](const double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+    };
+
+    std::cout << clients << " clients x " << requests << " requests against a store seeded with " << SEED_TASKS << " tasks\n"
+              << std::fixed << std::setprecision(0)
+              << "throughput: " << static_cast<double>(samples.size()) / seconds << " requests/s\n"
+              << std::setprecision(3)
+              << "latency (ms): p50 " << percentile(0.50) << "  p99 " << percentile(0.99) << "  max " << samples.back() << "\n"
+              << "stale reads: " << stale_reads << "\n";
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(scratch);
+    return stale_reads == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+/*
+ * Startup-time benchmark
+ * ------------------------------------------------------------------------------
+ * Launches the Task Manager CLI in one-shot mode over and over, inside a scratch
+ * directory, and reports the wall time from process launch to exit per command.
+ *
+ * Usage: TaskManagerStartupBench [runs] [path-to-TaskManagerCLI]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+static double LaunchOnce(const std::string &executable, const std::vector<std::string> &args)
+{
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(executable.c_str()));
+    for (const auto &arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    // The command's output is not part of what is measured
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    if (posix_spawn(&pid, executable.c_str(), &actions, nullptr, argv.data(), environ) != 0) {
+        std::cerr << "Unable to launch " << executable << "\n";
+        std::exit(1);
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    const auto end = std::chrono::steady_clock::now();
+    posix_spawn_file_actions_destroy(&actions);
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void Report(const std::string &name, std::vector<double> &samples)
+{
+    std::ranges::sort(samples);
+    const auto percentile = [&samples](const double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+    };
+
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << samples.front()
+              << std::setw(10) << percentile(0.50)
+              << std::setw(10) << percentile(0.95)
+              << std::setw(10) << samples.back() << "\n";
+}
+
+int main(const int argc, const char *argv[])
+{
+    const size_t runs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const std::string executable = std::filesystem::absolute(argc > 2 ? argv[2] : TASKS_EXECUTABLE).string();
+
+    if (runs == 0) {
+        std::cerr << "Usage: TaskManagerStartupBench [runs] [path-to-TaskManagerCLI]\n";
+        return 1;
+    }
+
+    // Every run starts from the same empty scratch directory, away from any real store
+    const auto scratch = std::filesystem::temp_directory_path() / ("tasks-startup-bench-" + std::to_string(getpid()));
+    std::filesystem::create_directories(scratch);
+    std::filesystem::current_path(scratch);
+
+    const std::vector<std::pair<std::string, std::vector<std::string>>> commands = {
+        {"help", {"help"}},
+        {"add --description (growing store)", {"add", "--description", "startup benchmark task", "--tags", "bench"}},
+        {"list --limit 10", {"list", "--limit", "10"}},
+        {"search --tags bench", {"search", "--tags", "bench"}},
+    };
+
+    std::cout << "Launch-to-exit latency over " << runs << " runs (ms)\n"
+              << std::left << std::setw(34) << "command" << std::right
+              << std::setw(10) << "min" << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "max" << "\n";
+
+    for (const auto &[name, args] : commands) {
+        std::vector<double> samples;
+        samples.reserve(runs);
+
+        for (size_t i = 0; i < runs; i++) {
+            samples.push_back(LaunchOnce(executable, args));
+        }
+
+        Report(name, samples);
+    }
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(scratch);
+    return 0;
+}
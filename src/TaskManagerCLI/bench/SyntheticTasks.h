@@ -0,0 +1,70 @@
+//
+// Created by DarsenOP on 10/19/26.
+//
+
+#ifndef SYNTHETICTASKS_H
+#define SYNTHETICTASKS_H
+
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TaskTable.h"
+
+/* Synthetic Tasks
+ * ------------------------------------------------------------------------------
+ * Deterministic stores for the benchmarks: fixed seed, fixed word and tag pools,
+ * so every run and every tool measures the same data.
+ */
+
+inline constexpr std::array<std::string_view, 16> WORDS = {
+    "fix", "login", "review", "deploy", "write", "report", "call", "plan",
+    "update", "docs", "budget", "test", "release", "meeting", "invoice", "backup"
+};
+
+inline constexpr size_t TAG_POOL = 50;
+
+// `std::mt19937_64` is specified bit for bit and only its raw output is used, so the data is the same everywhere
+inline TaskTable GenerateTasks(const size_t count)
+{
+    std::mt19937_64 random(20261019);
+    TaskTable tasks;
+    tasks.reserve(count);
+
+    std::string description;
+    std::vector<std::string> tags;
+
+    for (size_t i = 0; i < count; i++) {
+        Task task;
+        task.id = static_cast<unsigned int>(i + 1);
+
+        description.clear();
+        const size_t words = 2 + random() % 3;
+        for (size_t w = 0; w < words; w++) {
+            if (w > 0) description += ' ';
+            description += WORDS[random() % WORDS.size()];
+        }
+        tasks.SetDescription(task, description);
+
+        task.priority = static_cast<Priority>(random() % 4);
+        task.status = random() % 5 == 0 ? Status::Completed : Status::Pending;
+
+        if (random() % 10 < 7) {
+            const auto month = 1 + random() % 12;
+            const auto day = 1 + random() % 28;
+            task.due = static_cast<std::uint32_t>(2025 * 10000 + month * 100 + day);
+        }
+
+        tags.resize(random() % 4);
+        for (auto &tag : tags) tag = "tag" + std::to_string(random() % TAG_POOL);
+        tasks.SetTags(task, tags);
+
+        tasks.push_back(task);
+    }
+
+    return tasks;
+}
+
+#endif //SYNTHETICTASKS_H
@@ -4,87 +4,166 @@
 
 #include "taskpch.h"
 #include "Manager.h"
+#include "CommandLine.h"
+#include "Server.h"
 
 /*
- * GetInput(std::string& input, std::vector<std::string>& output)
+ * RunInteractive(Manager& manager) / RunBatch(Manager& manager, std::istream& input)
  * ------------------------------------------------------------------------------
- * Parses user input, splitting it into separate words.
- * - Words inside **double quotes ("...")** are treated as a **single argument**
- *   regardless of spaces within them.
- * - Extra spaces between words are ignored.
+ * - RunInteractive -> The `tasks>` prompt loop.
+ * - RunBatch       -> Executes one command per line of `input` without a prompt or emoji
+ *                     decoration. The whole batch is committed as a single unit.
+ * `tasks --serve PATH` keeps the manager resident and serves clients over a Unix
+ * socket (see Server.h). Any other arguments are run as a single command:
+ * `tasks <command> [flags]`. `tasks --record TRACE ...` records the commands of
+ * any of these modes (see TraceRecorder.h), and `tasks --pool PAGES ...` runs the
+ * interactive, batch and one-shot modes with the tasks left on disk and read
+ * through a buffer pool of PAGES pages of 64 KiB (see `Manager::UsePagedStore`).
  */
-void GetInput(const std::string &input, std::vector<std::string> &output, bool& empty_quote);
+int RunInteractive(Manager& manager);
+int RunBatch(Manager& manager, std::istream& input);
 
-int main(const int argc, const char *argv[])
+int main(int argc, const char *argv[])
 {
     /* Entry Point - Initializes Task Manager and Processes User Commands */
 
-    if (argc == 1 || (argc > 1 && static_cast<std::string>(argv[0]) == "/home/arsen/Documents/dev/project-portfolio/src/TaskManagerCLI/tasks")) {
-        Manager manager;
+    // `--record FILE` goes in front of any mode and traces every command the manager handles
+    std::unique_ptr<TraceRecorder> recorder;
+    if (argc >= 3 && std::string_view(argv[1]) == "--record") {
+        recorder = std::make_unique<TraceRecorder>(argv[2]);
+        if (!recorder->IsOpen()) {
+            std::cerr << "❌ Error: Unable to open trace file `" << argv[2] << "`\n";
+            return 1;
+        }
+
+        // The rest of the arguments are read as if `--record FILE` was not there
+        argc -= 2;
+        argv += 2;
+    }
+
+    // `--pool PAGES` comes next, bounding the memory the tasks take to that many pages
+    size_t pool_pages = 0;
+    if (argc >= 3 && std::string_view(argv[1]) == "--pool") {
+        const std::string_view value = argv[2];
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), pool_pages);
+        if (ec != std::errc() || end != value.data() + value.size() || pool_pages == 0) {
+            std::cerr << "❌ Error: `--pool` takes the number of pages to keep in memory, got `" << value << "`\n";
+            return 1;
+        }
+
+        argc -= 2;
+        argv += 2;
+    }
 
-        while (true) {
-            std::string input_str;
-            std::cout << "tasks> ";
-            std::getline(std::cin, input_str);
+    const auto setup = [&recorder, pool_pages](Manager& manager) {
+        manager.SetRecorder(recorder.get());
+        if (pool_pages != 0) manager.UsePagedStore(pool_pages);
+    };
 
-            std::vector<std::string> args;
-            bool empty_quotes;
-            GetInput(input_str, args, empty_quotes);
+    if (argc == 1) {
+        Manager manager;
+        setup(manager);
+        return RunInteractive(manager);
+    }
 
-            if (args.empty()) continue;
+    const std::string mode = argv[1];
 
-            if (empty_quotes) {
-                std::cout << "❌ Error: Quoted text cannot be empty or contain only spaces.\n"
-                          << "🔹 Example of correct usage: search --description \"important task\"\n"
-                          << "🔹 Incorrect: search --description \"   \" (only spaces inside quotes)\n";
-                continue;
-            }
+    if (argc == 2 && mode == "-") {
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
 
-            if (manager.HandleCommand(args.size(), args) == RunStatus::Exit) {
-                return 0;
-            }
+        Manager manager;
+        setup(manager);
+        return RunBatch(manager, std::cin);
+    }
+
+    if (argc == 3 && mode == "--batch") {
+        std::ifstream script(argv[2]);
+        if (!script) {
+            std::cerr << "❌ Error: Unable to open batch file `" << argv[2] << "`\n";
+            return 1;
         }
-    } else {
-        std::cerr << "❌ Invalid command: `" << argv[0] << "`\n"
-                  << "To enter Task Manager CLI, type: `tasks`\n";
+
+        std::ios::sync_with_stdio(false);
+
+        Manager manager;
+        setup(manager);
+        return RunBatch(manager, script);
+    }
+
+    if (argc == 3 && mode == "--serve" && pool_pages == 0) {
+        Server server(argv[2], std::max(2u, std::thread::hardware_concurrency()), recorder.get());
+        return server.Run();
+    }
+
+    if (mode == "-" || mode == "--batch" || mode == "--serve" || mode == "--record" || mode == "--pool") {
+        std::cerr << "❌ Invalid arguments.\n"
+                  << "To enter Task Manager CLI, type: `tasks`\n"
+                  << "To run commands from a file or a pipe, type: `tasks --batch FILE` or `tasks -`\n"
+                  << "To serve clients over a Unix socket, type: `tasks --serve PATH`\n"
+                  << "To run a single command, type: `tasks <command> [flags]`\n"
+                  << "To record the commands of any of these for `tasks-replay`, put `--record TRACE` first\n"
+                  << "To keep the tasks on disk behind a pool of N pages (no server), put `--pool N` next\n";
         return 1;
     }
+
+    // One-shot: the shell has already split the arguments, quotes included
+    std::ios::sync_with_stdio(false);
+
+    Manager manager;
+    setup(manager);
+    return manager.HandleOneShotCommand(std::vector<std::string>(argv + 1, argv + argc)) ? 0 : 1;
 }
 
-void GetInput(const std::string& input, std::vector<std::string>& output, bool& empty_quote)
+int RunInteractive(Manager& manager)
 {
-    std::string current_arg;
-    bool inside_quotes{false};
-    empty_quote = false;
-
-    for (const char c : input) {
-        if (c == ' ' && !inside_quotes) {
-            if (!current_arg.empty()) {
-                output.push_back(std::move(current_arg));
-                current_arg.clear();
-            }
-        } else if (c == '"') {
-            inside_quotes = !inside_quotes;
-
-            if (!inside_quotes && !current_arg.empty()) {
-                if (std::ranges::all_of(current_arg.begin(), current_arg.end(),
-                    [](const char chr){ return std::isspace(chr); })) {
-                    empty_quote = true;
-                    return;
-                }
-                output.push_back(std::move(current_arg));
-                current_arg.clear();
-            } else if (!inside_quotes && current_arg.empty()) {
-                empty_quote = true;
-                return;
-            }
-        } else {
-            current_arg += c;
+    std::string input_str;
+    CommandLine line;
+
+    while (true) {
+        std::cout << "tasks> ";
+        if (!std::getline(std::cin, input_str)) return 0;
+
+        bool empty_quotes;
+        GetInput(input_str, line, empty_quotes);
+
+        if (line.tokens.empty()) continue;
+
+        if (empty_quotes) {
+            PrintEmptyQuotesError();
+            continue;
+        }
+
+        if (manager.HandleCommand(line.tokens.size(), line.tokens) == RunStatus::Exit) {
+            return 0;
         }
     }
+}
 
-    // It is possible that the last word was not pushed into the vector, so we explicitly check for it
-    if (!current_arg.empty()) {
-        output.push_back(std::move(current_arg));
+int RunBatch(Manager& manager, std::istream& input)
+{
+    manager.SetPlainOutput(true);
+    manager.BeginBatch();
+
+    std::string input_str;
+    CommandLine line;
+
+    while (std::getline(input, input_str)) {
+        bool empty_quotes;
+        GetInput(input_str, line, empty_quotes);
+
+        if (line.tokens.empty()) continue;
+
+        if (empty_quotes) {
+            PrintEmptyQuotesError(std::cout, true);
+            continue;
+        }
+
+        if (manager.HandleCommand(line.tokens.size(), line.tokens) == RunStatus::Exit) {
+            break;
+        }
     }
+
+    manager.EndBatch();
+    return 0;
 }
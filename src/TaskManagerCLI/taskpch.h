@@ -21,8 +21,14 @@
 #include <numeric>
 #include <cstdint>
 #include <iterator>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <atomic>
 #include <nlohmann/json.hpp>
 #include <charconv>
+#include <limits>
+#include <span>
 #include <format>
 
 #endif //TASKPCH_H